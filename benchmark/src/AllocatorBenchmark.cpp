@@ -0,0 +1,89 @@
+/**
+ * @file AllocatorBenchmark.cpp
+ *
+ * This module measures the cost of parsing a batch of URIs and then
+ * freeing it, with every URI allocated either from the global allocator
+ * or from one monotonic arena released in a single step.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <Uri/Uri.hpp>
+#include <chrono>
+#include <memory_resource>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /**
+     * This builds the URI strings of a batch, with elements long enough
+     * that each one needs storage of its own.
+     */
+    std::vector<std::string> MakeInputs(size_t count) {
+        std::vector<std::string> inputs;
+        inputs.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            inputs.push_back("https://user" + std::to_string(i % 97) + "@cdn-" +
+                             std::to_string(i % 1013) + ".static.example.com:8443/assets/v" +
+                             std::to_string(i % 7) + "/images/thumbnail-" + std::to_string(i) +
+                             ".png?utm_source=newsletter&utm_medium=email&id=" +
+                             std::to_string(i * 7919) + "#section-" + std::to_string(i % 13));
+        }
+        return inputs;
+    }
+
+    /**
+     * This parses every input into a URI allocated from the given
+     * memory resource, then frees them all, returning the number
+     * of URIs parsed successfully.
+     */
+    size_t ParseBatch(const std::vector<std::string>& inputs, std::pmr::memory_resource* resource) {
+        std::vector<Uri::Uri> uris;
+        uris.reserve(inputs.size());
+        size_t parsed = 0;
+        for (const auto& input : inputs)
+        {
+            uris.emplace_back(resource);
+            if (uris.back().ParseFromString(input))
+            { ++parsed; }
+        }
+        return parsed;
+    }
+}  // namespace
+
+int main() {
+    const size_t batchSize = 1000000;
+    const size_t rounds = 5;
+    const auto inputs = MakeInputs(batchSize);
+    printf("%-20s%15s\n", "allocator", "ns per URI");
+    for (const bool useArena : {false, true})
+    {
+        double best = 0.0;
+        for (size_t round = 0; round < rounds; ++round)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            size_t parsed;
+            if (useArena)
+            {
+                std::pmr::monotonic_buffer_resource arena;
+                parsed = ParseBatch(inputs, &arena);
+            } else
+            { parsed = ParseBatch(inputs, std::pmr::new_delete_resource()); }
+            const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                               start)
+                                     .count();
+            if (parsed != batchSize)
+            {
+                fprintf(stderr, "only %zu of %zu URIs parsed\n", parsed, batchSize);
+                return 1;
+            }
+            if ((round == 0) || (elapsed < best))
+            { best = elapsed; }
+        }
+        printf("%-20s%15.1f\n", useArena ? "monotonic arena" : "global", best * 1e9 / batchSize);
+    }
+    return 0;
+}
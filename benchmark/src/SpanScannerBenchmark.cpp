@@ -0,0 +1,93 @@
+/**
+ * @file SpanScannerBenchmark.cpp
+ *
+ * This module measures the throughput of each implementation of the
+ * span scanner on the same inputs: URI elements made of long runs of
+ * unreserved characters, like those found in tracking URLs.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <src/SpanScanner.hpp>
+#include <chrono>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /**
+     * This is the set of characters scanned over, matching the
+     * "pchar" syntax of RFC 3986 leaving out "pct-encoded".
+     */
+    constexpr Uri::CharacterSet PCHAR{Uri::CharacterSet('a', 'z'), Uri::CharacterSet('A', 'Z'),
+                                      Uri::CharacterSet('0', '9'), '-', '.', '_', '~', '!', '$',
+                                      '&', '\'', '(', ')', '*', '+', ',', ';', '=', ':', '@'};
+
+    /**
+     * This is the name printed for each scan level.
+     */
+    const char* LevelName(Uri::ScanLevel level) {
+        switch (level)
+        {
+        case Uri::ScanLevel::Ssse3:
+            return "SSSE3";
+        case Uri::ScanLevel::Avx2:
+            return "AVX2";
+        case Uri::ScanLevel::Avx512:
+            return "AVX-512";
+        default:
+            return "scalar";
+        }
+    }
+
+    /**
+     * This builds an input of the given length made of pchar
+     * characters, ending with a "/" delimiter.
+     */
+    std::string MakeInput(size_t length) {
+        static const char alphabet[] = "utm_source=newsletter&utm_medium=email-campaign.2024~";
+        std::string input;
+        for (size_t i = 0; i + 1 < length; ++i)
+        { input.push_back(alphabet[i % (sizeof(alphabet) - 1)]); }
+        input.push_back('/');
+        return input;
+    }
+}  // namespace
+
+int main() {
+    const std::vector<size_t> lengths{8, 16, 32, 64, 128, 512, 4096};
+    const size_t bytesPerRun = 64 * 1024 * 1024;
+    printf("supported level: %s\n", LevelName(Uri::GetSupportedScanLevel()));
+    printf("%-10s", "length");
+    for (auto length : lengths)
+    { printf("%10zu", length); }
+    printf("   (MB/s)\n");
+    for (auto level : {Uri::ScanLevel::Scalar, Uri::ScanLevel::Ssse3, Uri::ScanLevel::Avx2,
+                       Uri::ScanLevel::Avx512})
+    {
+        if (level > Uri::GetSupportedScanLevel())
+        { continue; }
+        printf("%-10s", LevelName(level));
+        for (auto length : lengths)
+        {
+            const auto input = MakeInput(length);
+            const auto iterations = bytesPerRun / length;
+            size_t checksum = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+            { checksum += Uri::FindFirstNotInSet(PCHAR, input.data(), input.length(), level); }
+            const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                               start)
+                                     .count();
+            if (checksum != iterations * (length - 1))
+            {
+                fprintf(stderr, "\n%s gave a wrong result\n", LevelName(level));
+                return 1;
+            }
+            printf("%10.0f", (double)(iterations * length) / elapsed / 1e6);
+        }
+        printf("\n");
+    }
+    return 0;
+}
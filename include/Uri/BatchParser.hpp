@@ -0,0 +1,149 @@
+#ifndef URI_BATCH_PARSER_HPP
+#define URI_BATCH_PARSER_HPP
+/**
+ * @file BatchParser.hpp
+ *
+ * This module contains the declaration of the Uri::BatchParser class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <Uri/Uri.hpp>
+#include <memory>
+#include <memory_resource>
+#include <stddef.h>
+#include <stdint.h>
+#include <string_view>
+#include <vector>
+
+namespace Uri
+{
+    /**
+     * This holds the outcome of parsing a batch of URI strings,
+     * in the same order as the strings were given.
+     */
+    struct BatchParseResults
+    {
+        /**
+         * These are the URIs parsed, one per string.  The URI for
+         * a string which failed to parse is left in an unspecified state.
+         */
+        std::vector<Uri> uris;
+
+        /**
+         * This is the memory resource from which the URIs of the
+         * results are allocated.  It must outlive them.  If it is
+         * changed between batches, a URI kept from an earlier batch
+         * is replaced by one from the new resource when reused.
+         */
+        std::pmr::memory_resource* memoryResource = std::pmr::get_default_resource();
+
+        /**
+         * This is a bitmap of which strings were parsed successfully,
+         * holding the bit for string i at bit (i % 64) of word (i / 64).
+         */
+        std::vector<uint64_t> parsed;
+
+        /**
+         * This is the number of strings which were parsed successfully.
+         */
+        size_t parsedCount = 0;
+
+        /**
+         * This method returns an indication of whether or not
+         * the string at the given index was parsed successfully.
+         *
+         * @param[in] index
+         *      This is the index of the string in the batch.
+         * @return
+         *      An indication of whether or not the string at the
+         *      given index was parsed successfully is returned.
+         */
+        bool IsParsed(size_t index) const {
+            return (((parsed[index / 64] >> (index % 64)) & 1) != 0);
+        }
+    };
+
+    /**
+     * This class parses large batches of URI strings, spreading
+     * the work over a pool of threads which it keeps for its lifetime.
+     *
+     * @note
+     *      The URIs of a results structure are reused from one batch
+     *      to the next, so parsing batch after batch into the same
+     *      results keeps the storage of every URI allocated.
+     */
+    class BatchParser
+    {
+        // Lifecycle management
+    public:
+        ~BatchParser();
+        BatchParser(const BatchParser&) = delete;
+        BatchParser(BatchParser&&) = delete;
+        BatchParser& operator=(const BatchParser&) = delete;
+        BatchParser& operator=(BatchParser&&) = delete;
+
+        // public methods
+    public:
+        /**
+         * This constructs the parser and starts its threads.
+         *
+         * @param[in] threadCount
+         *      This is the number of threads to parse with, counting
+         *      the thread which calls the parser.  If zero, one thread
+         *      per hardware thread is used.
+         */
+        explicit BatchParser(size_t threadCount = 0);
+
+        /**
+         * This method returns the number of threads the parser uses,
+         * counting the thread which calls it.
+         *
+         * @return
+         *      The number of threads the parser uses is returned.
+         */
+        size_t GetThreadCount() const;
+
+        /**
+         * This method parses every one of the given URI strings.
+         *
+         * @param[in] inputs
+         *      This points to the first of the URI strings to parse.
+         * @param[in] count
+         *      This is the number of URI strings to parse.
+         * @param[in, out] results
+         *      This is where to store the URIs parsed and which
+         *      of them were parsed successfully.
+         */
+        void ParseBatch(const std::string_view* inputs, size_t count, BatchParseResults& results);
+
+        /**
+         * This method parses every line of the given buffer as a URI
+         * string.  Lines end with "\n" or "\r\n", and a last line with
+         * no line ending is parsed as well.
+         *
+         * @param[in] lines
+         *      This is the buffer holding the URI strings to parse.
+         * @param[in, out] results
+         *      This is where to store the URIs parsed and which
+         *      of them were parsed successfully.
+         */
+        void ParseBatchLines(std::string_view lines, BatchParseResults& results);
+
+        // private properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance. It is defined in the implementation
+         * and declared here to ensure that iwt is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr<struct Impl> impl_;
+    };
+}  // namespace Uri
+
+#endif /* URI_BATCH_PARSER_HPP */
@@ -0,0 +1,274 @@
+#ifndef URI_COMPACT_URI_HPP
+#define URI_COMPACT_URI_HPP
+/**
+ * @file CompactUri.hpp
+ *
+ * This module contains the declaration of the Uri::CompactUri class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <Uri/PathSegments.hpp>
+#include <Uri/Uri.hpp>
+#include <functional>
+#include <stddef.h>
+#include <stdint.h>
+#include <string_view>
+
+namespace Uri
+{
+    /**
+     * This class is an immutable, compact representation of a parsed URI,
+     * meant for holding very many URIs in memory at once.
+     *
+     * Every decoded element, and the offset of the end of each path
+     * segment, is packed into a single block, which is kept inside
+     * the object itself when it is small enough and in one heap
+     * allocation otherwise.  The presence of a port, query and fragment,
+     * and the kind of host, are packed into flags, and the accessors
+     * are all inline.
+     *
+     * The packing is canonical: two compact URIs are equal exactly when
+     * the URIs they were made from are, and that is found by comparing
+     * a fixed-size header and one block of memory.
+     */
+    class CompactUri
+    {
+        // Lifecycle management
+    public:
+        ~CompactUri();
+        CompactUri(const CompactUri& other);
+        CompactUri(CompactUri&& other) noexcept;
+        CompactUri& operator=(const CompactUri& other);
+        CompactUri& operator=(CompactUri&& other) noexcept;
+
+        // public methods
+    public:
+        /**
+         * This constructs an empty URI.  It never allocates.
+         */
+        CompactUri() = default;
+
+        /**
+         * This constructs the compact representation of the given URI.
+         *
+         * @param[in] uri
+         *      This is the URI to represent.
+         */
+        explicit CompactUri(const Uri& uri);
+
+        /**
+         * This method replaces the URI with the one parsed
+         * from the given string.
+         *
+         * @param[in] uriString
+         *      This is the string rendering of the URI to parse.
+         * @return
+         *      whether or not the URI was parsed sucssefully is returnd.
+         *      If not, the URI is left unchanged.
+         */
+        bool ParseFromString(std::string_view uriString);
+
+        /**
+         * This method returns the URI this represents, as a Uri::Uri.
+         *
+         * @return
+         *      The URI this represents is returned.
+         */
+        Uri ToUri() const;
+
+        /**
+         * These are the comparison operators for the class.
+         */
+        bool operator==(const CompactUri& other) const;
+        bool operator!=(const CompactUri& other) const { return !(*this == other); }
+
+        /**
+         * This method returns a hash of the URI, which is the same
+         * for any two URIs comparing equal.
+         *
+         * @return
+         *      The hash of the URI is returned.
+         */
+        size_t GetHash() const;
+
+        /**
+         * This method returns the number of bytes the URI holds
+         * on the heap, on top of the size of the object itself.
+         *
+         * @return
+         *      The number of bytes the URI holds on the heap is returned.
+         */
+        size_t GetHeapSize() const {
+            return IsInline() ? 0 : (GetWordCount() * sizeof(uint32_t));
+        }
+
+        /**
+         * These methods return the decoded elements of the URI.
+         * An IPv6 host is returned in the canonical text of RFC 5952.
+         */
+        std::string_view GetScheme() const { return GetElement(SCHEME); }
+        std::string_view GetUserName() const { return GetElement(USER_NAME); }
+        std::string_view GetUserPass() const { return GetElement(USER_PASS); }
+        std::string_view GetHost() const { return GetElement(HOST); }
+        std::string_view GetQuery() const { return GetElement(QUERY); }
+        std::string_view GetFragment() const { return GetElement(FRAGMENT); }
+
+        /**
+         * This method returns the kind of the "host" element of the URI.
+         */
+        HostKind GetHostKind() const {
+            return (HostKind)((flags_ & HOST_KIND_MASK) >> HOST_KIND_SHIFT);
+        }
+
+        /**
+         * This methode returns an indication of whether or not
+         * the URI is a relative reference.
+         */
+        bool IsRelativeReference() const { return (ends_[SCHEME] == 0); }
+
+        /**
+         * These methods return whether or not the URI includes
+         * a port number, a query and a fragment.
+         */
+        bool HasPort() const { return ((flags_ & HAS_PORT) != 0); }
+        bool HasQuery() const { return ((flags_ & HAS_QUERY) != 0); }
+        bool HasFragment() const { return ((flags_ & HAS_FRAGMENT) != 0); }
+
+        /**
+         * This method returns the port number of the URI.
+         * It is only valid if HasPort returns true.
+         */
+        uint16_t GetPort() const { return port_; }
+
+        /**
+         * This method returns the "path" element of the URI
+         * as a range of segments.
+         */
+        PathSegments GetPathSegments() const {
+            return PathSegments(GetElement(PATH), GetWords(), segmentCount_);
+        }
+
+        // Private methods
+    private:
+        /**
+         * These are the elements of the URI, in the order
+         * in which they are packed.
+         */
+        enum Element : uint8_t
+        {
+            SCHEME,
+            USER_NAME,
+            USER_PASS,
+            HOST,
+            PATH,
+            QUERY,
+            FRAGMENT,
+            ELEMENT_COUNT
+        };
+
+        /**
+         * These are the presence flags.
+         */
+        static constexpr uint8_t HAS_PORT = 0x01;
+        static constexpr uint8_t HAS_QUERY = 0x02;
+        static constexpr uint8_t HAS_FRAGMENT = 0x04;
+
+        /**
+         * These are where the kind of host is packed in the flags.
+         */
+        static constexpr uint8_t HOST_KIND_SHIFT = 3;
+        static constexpr uint8_t HOST_KIND_MASK = 0x18;
+
+        /**
+         * This is the largest block kept inside the object.
+         */
+        static constexpr size_t INLINE_WORDS = 6;
+
+        /**
+         * This method returns the number of bytes in the block:
+         * the path segment offsets followed by the text of the elements.
+         */
+        size_t GetBlockSize() const {
+            return segmentCount_ * sizeof(uint32_t) + ends_[ELEMENT_COUNT - 1];
+        }
+
+        /**
+         * This method returns the number of 32-bit words the block takes.
+         */
+        size_t GetWordCount() const { return (GetBlockSize() + 3) / sizeof(uint32_t); }
+
+        /**
+         * This method returns an indication of whether or not
+         * the block is kept inside the object.
+         */
+        bool IsInline() const { return (GetWordCount() <= INLINE_WORDS); }
+
+        /**
+         * This method returns the start of the block, which begins
+         * with the offset of the end of each path segment.
+         */
+        const uint32_t* GetWords() const { return IsInline() ? storage_.inlineWords : storage_.heap; }
+
+        /**
+         * This method returns the given element of the URI.
+         */
+        std::string_view GetElement(Element element) const {
+            const auto text = (const char*)(GetWords() + segmentCount_);
+            const auto start = (element == SCHEME) ? 0 : ends_[element - 1];
+            return std::string_view(text + start, ends_[element] - start);
+        }
+
+        /**
+         * This method frees the block, if it is on the heap.
+         */
+        void Release();
+
+        /**
+         * This method makes the block a copy of the block
+         * of the given URI, whose header has already been copied.
+         */
+        void CopyBlock(const CompactUri& other);
+
+        // Properties
+    private:
+        /**
+         * This is the block, or a pointer to it on the heap.
+         */
+        union Storage
+        {
+            uint32_t* heap;
+            uint32_t inlineWords[INLINE_WORDS];
+        } storage_{};
+
+        /**
+         * This is the offset in the text of the end of each element.
+         */
+        uint32_t ends_[ELEMENT_COUNT] = {};
+
+        /**
+         * This is the number of path segments.
+         */
+        uint32_t segmentCount_ = 0;
+
+        /**
+         * This is the port number, if the URI has one.
+         */
+        uint16_t port_ = 0;
+
+        /**
+         * These are the presence flags and the kind of host.
+         */
+        uint8_t flags_ = 0;
+    };
+}  // namespace Uri
+
+namespace std
+{
+    template <> struct hash<Uri::CompactUri>
+    {
+        size_t operator()(const Uri::CompactUri& uri) const { return uri.GetHash(); }
+    };
+}  // namespace std
+
+#endif /* URI_COMPACT_URI_HPP */
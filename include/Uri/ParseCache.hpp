@@ -0,0 +1,135 @@
+#ifndef URI_PARSE_CACHE_HPP
+#define URI_PARSE_CACHE_HPP
+/**
+ * @file ParseCache.hpp
+ *
+ * This module contains the declaration of the Uri::ParseCache class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <Uri/Uri.hpp>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <string_view>
+
+namespace Uri
+{
+    /**
+     * These are the counters kept by a parse cache.
+     */
+    struct ParseCacheStatistics
+    {
+        /**
+         * This is the number of URI strings found in the cache.
+         */
+        uint64_t hits = 0;
+
+        /**
+         * This is the number of URI strings not found in the cache,
+         * which had to be parsed.
+         */
+        uint64_t misses = 0;
+
+        /**
+         * This is the number of URIs dropped from the cache
+         * to make room for others.
+         */
+        uint64_t evictions = 0;
+    };
+
+    /**
+     * This class is a bounded cache of parsed URIs, keyed by the
+     * URI strings they were parsed from, which may be shared by
+     * any number of threads.
+     *
+     * The cache is split into shards, each with its own lock, so that
+     * threads looking up different strings rarely wait on each other.
+     * When a shard is full, the CLOCK algorithm picks the URI to drop:
+     * URIs found since the clock hand last passed them are skipped once.
+     *
+     * @note
+     *      The URIs are shared and must not be changed.  Everything
+     *      worked out lazily about them (the decoded and encoded
+     *      elements, the path segments and the hash) is worked out
+     *      before they are shared, so reading them from several
+     *      threads at once is safe.
+     */
+    class ParseCache
+    {
+        // Lifecycle management
+    public:
+        ~ParseCache();
+        ParseCache(const ParseCache&) = delete;
+        ParseCache(ParseCache&&) = delete;
+        ParseCache& operator=(const ParseCache&) = delete;
+        ParseCache& operator=(ParseCache&&) = delete;
+
+        // public methods
+    public:
+        /**
+         * This constructs an empty cache.
+         *
+         * @param[in] capacity
+         *      This is the number of URIs the cache can hold.
+         *      It is shared evenly by the shards, rounding up.
+         * @param[in] shardCount
+         *      This is the number of shards to split the cache into.
+         */
+        explicit ParseCache(size_t capacity, size_t shardCount = 16);
+
+        /**
+         * This method returns the URI parsed from the given string,
+         * parsing it and adding it to the cache if it isn't there yet.
+         *
+         * @param[in] uriString
+         *      This is the string rendering of the URI to parse.
+         * @return
+         *      The URI parsed from the given string is returned.
+         * @retval nullptr
+         *      This is returned if the string could not be parsed.
+         *      Strings which can't be parsed are not cached.
+         */
+        std::shared_ptr<const Uri> Parse(std::string_view uriString);
+
+        /**
+         * This method returns the number of URIs in the cache.
+         *
+         * @return
+         *      The number of URIs in the cache is returned.
+         */
+        size_t GetSize() const;
+
+        /**
+         * This method returns the counters of the cache,
+         * added up over every shard.
+         *
+         * @return
+         *      The counters of the cache are returned.
+         */
+        ParseCacheStatistics GetStatistics() const;
+
+        /**
+         * This method drops every URI from the cache.
+         * The counters are kept.
+         */
+        void Clear();
+
+        // private properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance. It is defined in the implementation
+         * and declared here to ensure that iwt is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr<struct Impl> impl_;
+    };
+}  // namespace Uri
+
+#endif /* URI_PARSE_CACHE_HPP */
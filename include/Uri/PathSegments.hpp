@@ -0,0 +1,133 @@
+#ifndef URI_PATH_SEGMENTS_HPP
+#define URI_PATH_SEGMENTS_HPP
+/**
+ * @file PathSegments.hpp
+ *
+ * This module contains the declaration of the Uri::PathSegments class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <iterator>
+#include <stddef.h>
+#include <stdint.h>
+#include <string_view>
+
+namespace Uri
+{
+    /**
+     * This class is a read-only range over the segments of the path
+     * of a Uri::Uri, each one given as a view into the single buffer
+     * in which the URI keeps its whole path.
+     *
+     * @note
+     *      The range and the views it hands out are only valid until
+     *      the path of the URI they came from is next changed.
+     */
+    class PathSegments
+    {
+        // Types
+    public:
+        /**
+         * This is the type of iterator over the segments.
+         */
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = ptrdiff_t;
+            using pointer = const std::string_view*;
+            using reference = std::string_view;
+
+            Iterator() = default;
+
+            Iterator(const char* buffer, const uint32_t* segmentEnds, size_t index)
+                : buffer_(buffer), segmentEnds_(segmentEnds), index_(index) {}
+
+            std::string_view operator*() const {
+                const size_t start = (index_ == 0) ? 0 : (segmentEnds_[index_ - 1] + 1);
+                return std::string_view(buffer_ + start, segmentEnds_[index_] - start);
+            }
+
+            Iterator& operator++() {
+                ++index_;
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                auto previous = *this;
+                ++index_;
+                return previous;
+            }
+
+            bool operator==(const Iterator& other) const { return index_ == other.index_; }
+
+            bool operator!=(const Iterator& other) const { return index_ != other.index_; }
+
+        private:
+            const char* buffer_ = nullptr;
+            const uint32_t* segmentEnds_ = nullptr;
+            size_t index_ = 0;
+        };
+
+        // Methods
+    public:
+        PathSegments() = default;
+
+        /**
+         * This constructs the range over the given path buffer.
+         *
+         * @param[in] buffer
+         *      This is the buffer holding every segment, each one
+         *      separated from the next by a single character.
+         * @param[in] segmentEnds
+         *      This points to the offset in the buffer just past
+         *      the end of each segment.
+         * @param[in] count
+         *      This is the number of segments.
+         */
+        PathSegments(std::string_view buffer, const uint32_t* segmentEnds, size_t count)
+            : buffer_(buffer), segmentEnds_(segmentEnds), count_(count) {}
+
+        /**
+         * This method returns the number of segments in the path.
+         */
+        size_t size() const { return count_; }
+
+        /**
+         * This method returns an indication of whether or not
+         * the path has no segments at all.
+         */
+        bool empty() const { return count_ == 0; }
+
+        /**
+         * This method returns the segment at the given index,
+         * which must be less than the number of segments.
+         */
+        std::string_view operator[](size_t index) const {
+            return *Iterator(buffer_.data(), segmentEnds_, index);
+        }
+
+        /**
+         * These methods return the first and the last segments.
+         * The path must not be empty.
+         */
+        std::string_view front() const { return (*this)[0]; }
+        std::string_view back() const { return (*this)[count_ - 1]; }
+
+        /**
+         * These methods return the iterators over the segments.
+         */
+        Iterator begin() const { return Iterator(buffer_.data(), segmentEnds_, 0); }
+        Iterator end() const { return Iterator(buffer_.data(), segmentEnds_, count_); }
+
+        // Properties
+    private:
+        std::string_view buffer_;
+        const uint32_t* segmentEnds_ = nullptr;
+        size_t count_ = 0;
+    };
+}  // namespace Uri
+
+#endif /* URI_PATH_SEGMENTS_HPP */
@@ -0,0 +1,112 @@
+#ifndef URI_PUSH_PARSER_HPP
+#define URI_PUSH_PARSER_HPP
+/**
+ * @file PushParser.hpp
+ *
+ * This module contains the declaration of the Uri::PushParser class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <Uri/Uri.hpp>
+#include <memory>
+#include <stddef.h>
+#include <string_view>
+
+namespace Uri
+{
+    /**
+     * This class parses a URI string handed over in pieces, such as
+     * a request target split across socket reads, or wrapping around
+     * the end of a ring buffer, without putting the pieces together.
+     *
+     * The path, query and fragment are checked and decoded as they
+     * arrive.  Only the scheme, while it can't yet be told from the
+     * start of a path, and the authority are kept as they are until
+     * their end is seen.
+     *
+     * Once every piece is handed over, Finish gives the same URI
+     * as ParseFromString would for the whole string.
+     */
+    class PushParser
+    {
+        // Lifecycle management
+    public:
+        ~PushParser();
+        PushParser(const PushParser&) = delete;
+        PushParser(PushParser&&) noexcept;
+        PushParser& operator=(const PushParser&) = delete;
+        PushParser& operator=(PushParser&&) noexcept;
+
+        // public methods
+    public:
+        /**
+         * This constructs a parser ready for the first piece of a URI string.
+         */
+        PushParser();
+
+        /**
+         * This method drops whatever was handed over so far,
+         * making the parser ready for a new URI string.
+         */
+        void Reset();
+
+        /**
+         * This method hands over the next piece of the URI string.
+         *
+         * @param[in] chunk
+         *      This is the next piece of the URI string.
+         *      It isn't needed once this returns.
+         * @return
+         *      An indication of whether or not the URI string
+         *      may still be valid is returned.  Once it is known not
+         *      to be, further pieces are ignored.
+         */
+        bool Feed(std::string_view chunk);
+
+        /**
+         * This method hands over the next pieces of the URI string,
+         * from scattered buffers, in order.
+         *
+         * @param[in] chunks
+         *      These are the next pieces of the URI string.  An array
+         *      of iovec maps onto them one for one.
+         * @param[in] count
+         *      This is the number of pieces.
+         * @return
+         *      An indication of whether or not the URI string
+         *      may still be valid is returned.
+         */
+        bool Feed(const std::string_view* chunks, size_t count);
+
+        /**
+         * This method marks the end of the URI string and hands
+         * over the URI parsed from it.  The parser is then ready
+         * for a new URI string.
+         *
+         * @param[out] uri
+         *      This is where to store the URI parsed.
+         *      It is left unchanged if the URI string is not valid.
+         * @return
+         *      An indication of whether or not the URI string
+         *      was parsed successfully is returned.
+         */
+        bool Finish(Uri& uri);
+
+        // private properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance. It is defined in the implementation
+         * and declared here to ensure that iwt is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr<struct Impl> impl_;
+    };
+}  // namespace Uri
+
+#endif /* URI_PUSH_PARSER_HPP */
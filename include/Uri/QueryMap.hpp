@@ -0,0 +1,281 @@
+#ifndef URI_QUERY_MAP_HPP
+#define URI_QUERY_MAP_HPP
+/**
+ * @file QueryMap.hpp
+ *
+ * This module contains the declaration of the Uri::QueryMap class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <Uri/QueryParameters.hpp>
+#include <iterator>
+#include <stddef.h>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Uri
+{
+    /**
+     * This class holds the decoded parameters of a query, sorted by key.
+     * The decoded text of every key and value is kept in one buffer,
+     * and each parameter is a set of offsets into it, so building the
+     * map allocates twice at most, however many parameters there are.
+     * Parameters sharing a key are kept next to each other, in the order
+     * they were added.
+     *
+     * Looking up a key is a binary search, and GenerateString renders
+     * the parameters in a canonical form: sorted by key, with everything
+     * but unreserved characters percent-encoded.  Two queries which
+     * differ only in the order of their keys, or in how their keys and
+     * values were encoded, have the same canonical form, which makes it
+     * suitable as part of a cache key.
+     */
+    class QueryMap
+    {
+        // Types
+    public:
+        /**
+         * This holds one decoded parameter, as views of the map.
+         */
+        struct Entry
+        {
+            std::string_view key;
+            std::string_view value;
+        };
+
+    private:
+        /**
+         * This is where the key and value of a parameter lie
+         * in the text of the map.
+         */
+        struct Slot
+        {
+            size_t keyOffset;
+            size_t keyLength;
+            size_t valueOffset;
+            size_t valueLength;
+        };
+
+    public:
+        /**
+         * This is the type of iterator over the parameters.
+         */
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Entry;
+            using difference_type = ptrdiff_t;
+            using pointer = const Entry*;
+            using reference = Entry;
+
+            const_iterator() = default;
+
+            const_iterator(const char* text, const Slot* slot) : text_(text), slot_(slot) {}
+
+            Entry operator*() const {
+                return Entry{std::string_view(text_ + slot_->keyOffset, slot_->keyLength),
+                             std::string_view(text_ + slot_->valueOffset, slot_->valueLength)};
+            }
+
+            const_iterator& operator++() {
+                ++slot_;
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                auto previous = *this;
+                ++slot_;
+                return previous;
+            }
+
+            bool operator==(const const_iterator& other) const { return slot_ == other.slot_; }
+
+            bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+        private:
+            const char* text_ = nullptr;
+            const Slot* slot_ = nullptr;
+        };
+
+        /**
+         * This is a range over some of the parameters.
+         */
+        struct Range
+        {
+            const_iterator first;
+            const_iterator last;
+
+            const_iterator begin() const { return first; }
+            const_iterator end() const { return last; }
+            bool empty() const { return (first == last); }
+        };
+
+        // public methods
+    public:
+        /**
+         * This constructs an empty map.
+         */
+        QueryMap() = default;
+
+        /**
+         * This constructs the map of the given parameters, decoding each
+         * key and value as DecodeQueryComponent does, with "+" as space.
+         *
+         * @param[in] parameters
+         *      These are the parameters to hold, such as those returned
+         *      by Uri::GetQueryParameters.
+         */
+        explicit QueryMap(const QueryParameters& parameters);
+
+        /**
+         * This method returns an indication of whether or not
+         * there is a parameter with the given key.
+         *
+         * @param[in] key
+         *      This is the decoded key to look for.
+         * @return
+         *      true if there is a parameter with the key else false.
+         */
+        bool Has(std::string_view key) const;
+
+        /**
+         * This method returns the value of the first parameter
+         * with the given key.
+         *
+         * @param[in] key
+         *      This is the decoded key to look for.
+         * @return
+         *      The decoded value is returned.  It is only valid until
+         *      the map is next changed.
+         * @retval ""
+         *      An empty view is returned if there is no parameter with
+         *      the key.  Has tells this apart from an empty value.
+         */
+        std::string_view Get(std::string_view key) const;
+
+        /**
+         * This method returns the parameters with the given key,
+         * in the order they were added, without copying them.
+         *
+         * @param[in] key
+         *      This is the decoded key to look for.
+         * @return
+         *      The range of parameters with the key is returned.
+         *      It is only valid until the map is next changed.
+         */
+        Range GetAll(std::string_view key) const;
+
+        /**
+         * This method sets the value of the given key, replacing
+         * every parameter with the key by a single one.
+         *
+         * @param[in] key
+         *      This is the decoded key to set.
+         * @param[in] value
+         *      This is the decoded value to give it.
+         */
+        void Set(std::string_view key, std::string_view value);
+
+        /**
+         * This method removes every parameter with the given key.
+         *
+         * @param[in] key
+         *      This is the decoded key to remove.
+         * @return
+         *      The number of parameters removed is returned.
+         */
+        size_t Remove(std::string_view key);
+
+        /**
+         * This method returns the number of parameters held.
+         *
+         * @return
+         *      The number of parameters held is returned.
+         */
+        size_t GetSize() const { return slots_.size(); }
+
+        /**
+         * This method returns an indication of whether or not
+         * the map holds no parameters.
+         *
+         * @return
+         *      true if the map holds no parameters else false.
+         */
+        bool IsEmpty() const { return slots_.empty(); }
+
+        /**
+         * This method renders the parameters in their canonical form.
+         *
+         * @return
+         *      The canonical query is returned, encoded and without
+         *      the "?".  It is meant for ParseFromString or for comparing,
+         *      not for Uri::SetQuery, which would encode it again.
+         */
+        std::string GenerateString() const;
+
+        /**
+         * This method appends the canonical form of the parameters
+         * to the given buffer, allocating at most once.
+         *
+         * @param[in, out] buffer
+         *      This is the buffer to which to append the canonical query.
+         */
+        void AppendTo(std::string& buffer) const;
+
+        /**
+         * These methods return the iterators over the parameters,
+         * in order of key.
+         */
+        const_iterator begin() const { return const_iterator(text_.data(), slots_.data()); }
+        const_iterator end() const {
+            return const_iterator(text_.data(), slots_.data() + slots_.size());
+        }
+
+    private:
+        /**
+         * This method returns the range of slots with the given key.
+         *
+         * @param[in] key
+         *      This is the decoded key to look for.
+         * @return
+         *      The index of the first slot with the key and of the one
+         *      past the last are returned.
+         */
+        std::pair<size_t, size_t> FindSlots(std::string_view key) const;
+
+        /**
+         * This method moves every key and value in use to the front
+         * of the text, if most of the text is no longer in use, before
+         * text of the given length is added at its end.
+         *
+         * @param[in] length
+         *      This is the length of the text about to be added.
+         */
+        void MakeRoom(size_t length);
+
+        // Properties
+    private:
+        /**
+         * This holds the decoded key and value of every parameter,
+         * along with those of parameters changed or removed since
+         * the text was last compacted.
+         */
+        std::string text_;
+
+        /**
+         * This is the length of the text in use by the parameters.
+         */
+        size_t textInUse_ = 0;
+
+        /**
+         * These are the parameters, sorted by key.
+         */
+        std::vector<Slot> slots_;
+    };
+}  // namespace Uri
+
+#endif /* URI_QUERY_MAP_HPP */
@@ -0,0 +1,190 @@
+#ifndef URI_QUERY_PARAMETERS_HPP
+#define URI_QUERY_PARAMETERS_HPP
+/**
+ * @file QueryParameters.hpp
+ *
+ * This module contains the declaration of the Uri::QueryParameters class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <iterator>
+#include <stddef.h>
+#include <string>
+#include <string_view>
+
+namespace Uri
+{
+    /**
+     * This holds one parameter of a query, as views of its key
+     * and value, both still percent-encoded.
+     */
+    struct QueryParameter
+    {
+        std::string_view key;
+        std::string_view value;
+    };
+
+    /**
+     * This class is a read-only range over the parameters of a query
+     * of the "key=value" pairs separated by "&" kind, as in
+     * "application/x-www-form-urlencoded".  It works on the raw query,
+     * so that an encoded "&" or "=" ("%26" or "%3D") is kept as part
+     * of the key or value rather than taken as a separator.
+     *
+     * Empty pairs are skipped.  A pair without "=" has an empty value.
+     * Nothing is copied or decoded; DecodeQueryComponent decodes a key
+     * or value when needed.
+     *
+     * @note
+     *      The range and the views it hands out are only valid as long
+     *      as the query they came from.
+     */
+    class QueryParameters
+    {
+        // Types
+    public:
+        /**
+         * This is the type of iterator over the parameters.
+         */
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = QueryParameter;
+            using difference_type = ptrdiff_t;
+            using pointer = const QueryParameter*;
+            using reference = const QueryParameter&;
+
+            Iterator() = default;
+
+            explicit Iterator(std::string_view query) : rest_(query) { Advance(); }
+
+            const QueryParameter& operator*() const { return current_; }
+
+            const QueryParameter* operator->() const { return &current_; }
+
+            Iterator& operator++() {
+                Advance();
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                auto previous = *this;
+                Advance();
+                return previous;
+            }
+
+            bool operator==(const Iterator& other) const {
+                return current_.key.data() == other.current_.key.data();
+            }
+
+            bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+        private:
+            /**
+             * This method moves on to the next pair not empty,
+             * or to the end if there is none.
+             */
+            void Advance() {
+                while (!rest_.empty())
+                {
+                    const auto separator = rest_.find('&');
+                    const auto pair = rest_.substr(0, separator);
+                    rest_.remove_prefix((separator == std::string_view::npos) ? rest_.length()
+                                                                              : (separator + 1));
+                    if (pair.empty())
+                    { continue; }
+                    const auto equals = pair.find('=');
+                    current_.key = pair.substr(0, equals);
+                    current_.value = (equals == std::string_view::npos)
+                                         ? pair.substr(pair.length())
+                                         : pair.substr(equals + 1);
+                    return;
+                }
+                current_ = QueryParameter();
+            }
+
+            std::string_view rest_;
+            QueryParameter current_;
+        };
+
+        // Methods
+    public:
+        QueryParameters() = default;
+
+        /**
+         * This constructs the range over the given query.
+         *
+         * @param[in] rawQuery
+         *      This is the query, still percent-encoded, without the "?".
+         */
+        explicit QueryParameters(std::string_view rawQuery) : rawQuery_(rawQuery) {}
+
+        /**
+         * This method looks for the first parameter with the given key,
+         * comparing it to the keys as they are, without decoding them.
+         *
+         * @param[in] key
+         *      This is the key to look for.
+         * @param[out] value
+         *      This is where to store the raw value of the parameter.
+         * @return
+         *      An indication of whether or not the key was found is returned.
+         */
+        bool Find(std::string_view key, std::string_view& value) const {
+            for (const auto& parameter : *this)
+            {
+                if (parameter.key == key)
+                {
+                    value = parameter.value;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * This method returns the query the range works on.
+         *
+         * @return
+         *      The query is returned, still percent-encoded.
+         */
+        std::string_view GetRawQuery() const { return rawQuery_; }
+
+        /**
+         * These methods return the iterators over the parameters.
+         */
+        Iterator begin() const { return Iterator(rawQuery_); }
+        Iterator end() const { return Iterator(); }
+
+        // Properties
+    private:
+        std::string_view rawQuery_;
+    };
+
+    /**
+     * This function decodes a key or value of a query parameter.
+     * Well-formed percent-encodings are decoded, and "+" is turned
+     * into a space if asked, as in "application/x-www-form-urlencoded".
+     * Anything else, including a "%" not followed by two hex digits,
+     * is kept as it is.
+     *
+     * @param[in] encoded
+     *      This is the key or value to decode.
+     * @param[in, out] scratch
+     *      This is where the decoded characters are put, if there is
+     *      anything to decode.  Its previous contents are replaced,
+     *      but its capacity is kept, so reusing it avoids allocating.
+     * @param[in] plusAsSpace
+     *      This indicates whether or not to turn "+" into a space.
+     * @return
+     *      The decoded key or value is returned.  It is a view of
+     *      either the given one, if there was nothing to decode,
+     *      or the scratch string.
+     */
+    std::string_view DecodeQueryComponent(std::string_view encoded, std::string& scratch,
+                                          bool plusAsSpace = true);
+}  // namespace Uri
+
+#endif /* URI_QUERY_PARAMETERS_HPP */
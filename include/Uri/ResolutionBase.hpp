@@ -0,0 +1,118 @@
+#ifndef URI_RESOLUTION_BASE_HPP
+#define URI_RESOLUTION_BASE_HPP
+/**
+ * @file ResolutionBase.hpp
+ *
+ * This module contains the declaration of the Uri::ResolutionBase class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <Uri/Uri.hpp>
+#include <memory>
+#include <stddef.h>
+
+namespace Uri
+{
+    /**
+     * This class holds a base URI prepared for resolving many relative
+     * references against it, such as every link of a web page.
+     *
+     * The base is decoded once, and the prefix of its path onto which
+     * relative paths are merged is worked out once, so resolving
+     * a reference only copies the elements the target takes from
+     * the base.  Targets are resolved as Uri::Resolve would.
+     *
+     * Resolving never changes the object, so it may be done from
+     * several threads at once.
+     */
+    class ResolutionBase
+    {
+        // Lifecycle management
+    public:
+        ~ResolutionBase();
+        ResolutionBase(const ResolutionBase&) = delete;
+        ResolutionBase(ResolutionBase&&) noexcept;
+        ResolutionBase& operator=(const ResolutionBase&) = delete;
+        ResolutionBase& operator=(ResolutionBase&&) noexcept;
+
+        // public methods
+    public:
+        /**
+         * This constructs the resolution base from the given base URI.
+         *
+         * @param[in] base
+         *      This is the base URI, which should be absolute
+         *      (IsRelativeReference should return false).
+         */
+        explicit ResolutionBase(const Uri& base);
+
+        /**
+         * This method returns the base URI.
+         *
+         * @return
+         *      The base URI is returned.
+         */
+        const Uri& GetBase() const;
+
+        /**
+         * This method resolves the given relative reference against
+         * the base, storing the target in the given URI and reusing
+         * its storage.
+         *
+         * @param[in] relativeReference
+         *      This describe how to get to the target starting at the base.
+         * @param[out] target
+         *      This is where to store the resolved target URI.
+         *      It may be the relative reference itself.  It keeps
+         *      its memory resource either way.
+         */
+        void Resolve(const Uri& relativeReference, Uri& target) const;
+
+        /**
+         * This method resolves the given relative reference against the base.
+         *
+         * @param[in] relativeReference
+         *      This describe how to get to the target starting at the base.
+         * @return
+         *      The resolved target URI is returned.
+         */
+        Uri Resolve(const Uri& relativeReference) const;
+
+        /**
+         * This method resolves every one of the given relative references
+         * against the base.
+         *
+         * @param[in] relativeReferences
+         *      This points to the first of the references to resolve.
+         *      Each one is only read by the thread resolving it.
+         * @param[in] count
+         *      This is the number of references to resolve.
+         * @param[out] targets
+         *      This points to where to store the first of the targets,
+         *      one per reference.  Their storage is reused.
+         * @param[in] threadCount
+         *      This is the number of threads to resolve with, counting
+         *      the calling thread.  The threads are started for the call,
+         *      so more than one is only worth it for large batches.
+         */
+        void ResolveBatch(const Uri* relativeReferences, size_t count, Uri* targets,
+                          size_t threadCount = 1) const;
+
+        // private properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance. It is defined in the implementation
+         * and declared here to ensure that iwt is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr<struct Impl> impl_;
+    };
+}  // namespace Uri
+
+#endif /* URI_RESOLUTION_BASE_HPP */
@@ -12,10 +12,13 @@
 #include <iterator>
 #include <functional>
 #include <inttypes.h>
-#include <sstream>
+#include <Uri/PathSegments.hpp>
+#include <Uri/QueryParameters.hpp>
 #include <memory>
+#include <memory_resource>
 #include <stdio.h>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace Uri
@@ -36,9 +39,120 @@ namespace Uri
         }
     };
 
+    /**
+     * These are the kinds of numeric address a host may be.
+     */
+    enum class AddressFamily : uint8_t
+    {
+        None,
+        IPv4,
+        IPv6,
+    };
+
+    /**
+     * These are the kinds of host a URI may have, told apart
+     * when the host is parsed or set.  A URI without an authority
+     * has an empty host, which is a reg-name.
+     */
+    enum class HostKind : uint8_t
+    {
+        RegName,
+        IPv4,
+        IPv6,
+        IPvFuture,
+    };
+
+    /**
+     * This struct represents the numeric address of a host
+     * which is an IPv4 or IPv6 address.
+     */
+    struct HostAddress
+    {
+        /**
+         * This is the kind of address the host is, if any.
+         */
+        AddressFamily family = AddressFamily::None;
+
+        /**
+         * This is the IPv4 address, with its first octet
+         * in the most significant byte.
+         */
+        uint32_t ipv4 = 0;
+
+        /**
+         * These are the 16 bytes of the IPv6 address, in network order.
+         */
+        uint8_t ipv6[16] = {};
+    };
+
+    struct ParsedElements;
+    class PathStorage;
+
+    /**
+     * These are the ways in which the elements of a URI string
+     * may be decoded when it is parsed.
+     */
+    enum class Decoding
+    {
+        /**
+         * Every element is decoded while the URI string is parsed.
+         */
+        Eager,
+
+        /**
+         * The user information, path, query and fragment are checked
+         * while the URI string is parsed, but kept encoded, and each is
+         * only decoded the first time it is read.  The scheme, host
+         * and port are always decoded while parsing.
+         *
+         * Decoding an element changes the URI, so the first read of
+         * each of these elements must not race with any other call
+         * on the URI.
+         */
+        Lazy,
+    };
+
+    /**
+     * These are the elements of a URI which may be asked for when
+     * parsing a URI string.  They combine with "|" into a mask.
+     */
+    enum class ComponentMask : uint8_t
+    {
+        None = 0x00,
+        Scheme = 0x01,
+        UserInfo = 0x02,
+        Host = 0x04,
+        Port = 0x08,
+        Path = 0x10,
+        Query = 0x20,
+        Fragment = 0x40,
+        Authority = UserInfo | Host | Port,
+        All = Scheme | Authority | Path | Query | Fragment,
+    };
+
+    /**
+     * These operators combine and intersect masks of URI elements.
+     */
+    constexpr ComponentMask operator|(ComponentMask lhs, ComponentMask rhs) {
+        return (ComponentMask)((uint8_t)lhs | (uint8_t)rhs);
+    }
+    constexpr ComponentMask operator&(ComponentMask lhs, ComponentMask rhs) {
+        return (ComponentMask)((uint8_t)lhs & (uint8_t)rhs);
+    }
+
     /**
      * This class represents a Uniform Resource Identifier (URI),
      * as defined in RFC 3986 (https://tools/ieft.org/html/rfc3986).
+     *
+     * @note
+     *      Const methods may be called on the same URI from several
+     *      threads at once, except while the URI is lazily parsed and
+     *      not yet fully decoded.  Until then, the getters, GetRaw*,
+     *      GetHash and operator== decode elements into the URI itself,
+     *      so none of them may race with any other call on the URI.
+     *      Calling GetHash once, from one thread, decodes every element.
+     *      GetRaw* may also render an element the first time, as noted
+     *      there.
      */
 
     class Uri
@@ -50,12 +164,13 @@ namespace Uri
                           // existing object.
         // It ensures that a deep copy is performed if the object contains dynamically allocated
         // resources
-        Uri(Uri&&);  // Move Constructor that transfers resources from an expiring object to a newly
+        Uri(Uri&&) noexcept;  // Move Constructor that transfers resources from an expiring object to a newly
                      // constructed object.
         Uri& operator=(const Uri&);  // Copy Assignment Operation That assigns the values of one
                                      // object to another object using the assignment operator (=)
-        Uri& operator=(Uri&&);  // Move Assignment Operator: Amove assignment operator efficiently
-                                // transfers resources from one object to another.
+        Uri& operator=(Uri&&) noexcept;  // Move Assignment Operator: Amove assignment operator
+                                         // efficiently transfers resources from one object to
+                                         // another.
 
         // public methods
     public:
@@ -64,6 +179,44 @@ namespace Uri
          */
         Uri();
 
+        /**
+         * This constructs an empty URI whose elements are all allocated
+         * from the given memory resource, such as an arena shared by
+         * a whole batch of URIs.
+         *
+         * @param[in] resource
+         *      This is the memory resource from which to allocate the URI.
+         *      It must outlive the URI.
+         */
+        explicit Uri(std::pmr::memory_resource* resource);
+
+        /**
+         * This constructs a copy of the given URI whose elements are
+         * all allocated from the given memory resource.
+         *
+         * @param[in] other
+         *      This is the URI to copy.
+         * @param[in] resource
+         *      This is the memory resource from which to allocate the URI.
+         *      It must outlive the URI.
+         */
+        Uri(const Uri& other, std::pmr::memory_resource* resource);
+
+        /**
+         * This method returns the memory resource from which
+         * the elements of the URI are allocated.
+         *
+         * @note
+         *      Copy construction allocates from the default memory
+         *      resource, and copy assignment keeps the memory resource
+         *      of the target, as for the std::pmr containers.  A move
+         *      takes the memory resource along with the elements.
+         *
+         * @return
+         *      The memory resource of the URI is returned.
+         */
+        std::pmr::memory_resource* GetMemoryResource() const;
+
         /**
          * This is the equality comparison operator for the class
          *
@@ -82,6 +235,17 @@ namespace Uri
          *      An indication of whether or not this URI is equal to the other one
          */
         bool operator!=(const Uri& otherUri) const;
+
+        /**
+         * This method returns a hash of the URI, which is the same
+         * for any two URIs comparing equal.  It is computed from the
+         * elements of the URI the first time, and kept until the URI
+         * is next changed.
+         *
+         * @return
+         *      The hash of the URI is returned.  It is never zero.
+         */
+        size_t GetHash() const;
         /**
          * This method build the URI from the elements parsed
          * from the given string rendering of a URI
@@ -91,7 +255,65 @@ namespace Uri
          * @return
          *       whether or not the URI was parsed sucssefully is returnd.
          */
-        bool ParseFromString(const std::string& uriString);
+        bool ParseFromString(std::string_view uriString);
+
+        /**
+         * This method build the URI from the elements parsed
+         * from the given buffer holding the string rendering of a URI.
+         *
+         * @param[in] uriString
+         *       This points to the first character of the URI to parse.
+         * @param[in] length
+         *       This is the number of characters of the URI to parse.
+         * @return
+         *       whether or not the URI was parsed sucssefully is returnd.
+         */
+        bool ParseFromString(const char* uriString, size_t length);
+
+        /**
+         * This method build the URI from the elements parsed
+         * from the given string rendering of a URI, decoding
+         * its elements as asked.
+         *
+         * @note
+         *      A lazily parsed URI decodes an element the first time
+         *      it is read, so that first read must not race with any
+         *      other call on the same URI.
+         *      Comparing, hashing, rendering or resolving the URI
+         *      decodes every element.
+         *
+         * @param[in] uriString
+         *       This is the string rendering of the URI to parce.
+         * @param[in] decoding
+         *       This is when to decode the elements of the URI.
+         * @return
+         *       whether or not the URI was parsed sucssefully is returnd.
+         */
+        bool ParseFromString(std::string_view uriString, Decoding decoding);
+
+        /**
+         * This method build the URI from only the given elements
+         * of the given string rendering of a URI.  The string is only
+         * scanned as far as the last of those elements, and only they
+         * are checked and decoded.  Every other element of the URI
+         * is left empty and absent.
+         *
+         * @note
+         *      The elements not asked for are not checked, so a string
+         *      which is not a valid URI is parsed successfully as long
+         *      as the elements asked for are valid.
+         *
+         * @param[in] uriString
+         *       This is the string rendering of the URI to parce.
+         * @param[in] components
+         *       This is the set of elements to parse.
+         * @param[in] decoding
+         *       This is when to decode the elements of the URI.
+         * @return
+         *       whether or not the URI was parsed sucssefully is returnd.
+         */
+        bool ParseFromString(std::string_view uriString, ComponentMask components,
+                             Decoding decoding = Decoding::Eager);
 
         /**
          * This method returns the "scheme" element of the URI.
@@ -103,6 +325,21 @@ namespace Uri
          */
         std::string GetScheme() const;
 
+        /**
+         * This method returns the "scheme" element of the URI
+         * without copying it.
+         *
+         * @note
+         *      The view is only valid until the URI is next changed.
+         *      The same holds for every other method returning a view.
+         *
+         * @return
+         *      The "scheme" element of the URI.
+         * @retval ""
+         *      An empty view is returned if there is no "scheme" element in the URI.
+         */
+        std::string_view GetSchemeView() const;
+
         /**
          * This method returns the "host name" element of the URI.
          *
@@ -114,6 +351,38 @@ namespace Uri
          */
         std::string GetHost() const;
 
+        /**
+         * This method returns the "host name" element of the URI
+         * without copying it.
+         *
+         * @return
+         *      The "host name" element of the URI.
+         * @retval ""
+         *      An empty view is returned if there is no "host name" element in the URI.
+         */
+        std::string_view GetHostView() const;
+
+        /**
+         * This method returns the numeric address of the "host name"
+         * element of the URI, worked out when the host was parsed or set.
+         * An IP-literal host holding an IPv6 address has one, as does
+         * a host made of an IPv4 address in dotted decimal.
+         *
+         * @return
+         *      The numeric address of the host is returned.  Its family
+         *      is AddressFamily::None if the host is not an address.
+         */
+        HostAddress GetHostAddress() const;
+
+        /**
+         * This method returns the kind of the "host name" element
+         * of the URI, worked out when the host was parsed or set.
+         *
+         * @return
+         *      The kind of the host is returned.
+         */
+        HostKind GetHostKind() const;
+
         /**
          * This method returns the "path" element of the URI as a sequence of steps.
          *
@@ -127,6 +396,69 @@ namespace Uri
          */
         std::vector<std::string> GetPath() const;
 
+        /**
+         * This method returns the "path" element of the URI as a range
+         * of segments, without copying any of them.
+         *
+         * @note
+         *      The range is only valid until the path of the URI is next
+         *      changed.  Where each segment lies is worked out whenever
+         *      the path is set, so this only decodes the path of a lazily
+         *      parsed URI, if not done yet, and races with nothing once
+         *      the path is decoded.
+         *
+         * @return
+         *      The "path" element of the URI is returned
+         *      as a range of segments.
+         */
+        PathSegments GetPathSegments() const;
+
+        /**
+         * These methods return the user information, "path", "query"
+         * and "fragment" elements of the URI in their percent-encoded
+         * form, without decoding or copying them.
+         *
+         * @note
+         *      If the URI was parsed lazily and the element wasn't set
+         *      since, this is the element exactly as it appeared in the
+         *      URI string, at no cost.  So is the query of a URI parsed
+         *      eagerly or by a PushParser if it holds a "%", so that an
+         *      encoded delimiter stays encoded.  Otherwise it is the element
+         *      encoded as GenerateString would render it, worked out
+         *      the first time it is asked for into storage of its own.
+         *      A view stays valid until its element is next changed or
+         *      the URI is parsed again, whatever else is asked for.
+         *
+         * @note
+         *      Working out an encoded form changes the URI, so the first
+         *      call for an element which was changed since the URI was
+         *      parsed must not race with any other call on the URI.
+         *
+         * @return
+         *      The encoded element is returned.
+         * @retval ""
+         *      An empty view is returned if the element is empty or absent.
+         */
+        std::string_view GetRawUserInfo() const;
+        std::string_view GetRawPath() const;
+        std::string_view GetRawQuery() const;
+        std::string_view GetRawFragment() const;
+
+        /**
+         * This method returns the parameters of the "query" element
+         * of the URI, taken as "key=value" pairs separated by "&",
+         * without decoding or copying them.
+         *
+         * @note
+         *      The range works on GetRawQuery, so it is only valid
+         *      until the query of the URI is next changed.
+         *
+         * @return
+         *      The parameters of the query are returned as a range
+         *      of raw key and value pairs.
+         */
+        QueryParameters GetQueryParameters() const;
+
         /**
          * This method returns an indication of whether or not the URI
          * includes a port number.
@@ -189,6 +521,15 @@ namespace Uri
          */
         std::string GetQuery() const;
 
+        /**
+         * This methode returns the query element of the Uri
+         * without copying it.
+         *
+         * @return
+         *      return the query item if it exist
+         */
+        std::string_view GetQueryView() const;
+
         /**
          * This method returns an indication of whether or not the URI
          * includes a fragment.
@@ -207,6 +548,15 @@ namespace Uri
          */
         std::string GetFragment() const;
 
+        /**
+         * This method returns the fragment of the Uri
+         * without copying it.
+         *
+         * @return
+         *      return the fragment if it exist
+         */
+        std::string_view GetFragmentView() const;
+
         /**
          * This method returns the User information element.
          *
@@ -215,6 +565,16 @@ namespace Uri
          */
         UserInfo GetUserInfo() const;
 
+        /**
+         * These methods return the user name and the password parts
+         * of the user information element without copying them.
+         *
+         * @return
+         *      return the user name or the password
+         */
+        std::string_view GetUserNameView() const;
+        std::string_view GetUserPassView() const;
+
         /**
          * This method applies the "remove_dot_segment" routine according to
          * the RFC 3986 to the path segments of the URI, in order to normalize it.
@@ -222,6 +582,22 @@ namespace Uri
          */
         void NormalizePath();
 
+        /**
+         * This method applies the syntax-based normalization of RFC 3986,
+         * along with dropping default ports, in place:
+         * - the scheme and host are made lowercase;
+         * - a port which is the default one for the scheme is dropped;
+         * - percent-encodings of unreserved characters are decoded,
+         *   and the hex digits of the others made uppercase;
+         * - dot segments are removed from the path, as NormalizePath does.
+         *
+         * Elements are changed where they are stored, so nothing is
+         * allocated.  The encoded form of a lazily parsed element is
+         * normalized without decoding it, unless its path has dot
+         * segments to remove.
+         */
+        void Normalize();
+
         /**
          * This methode resolves a given relative refrence, based on the given
          * base URI, returning the resolved target URI.
@@ -238,15 +614,253 @@ namespace Uri
          */
         Uri Resolve(const Uri& relativeReference) const;
 
-        void SetScheme(const std::string& scheme);
-        void SetUserName(const std::string& user);
-        void SetUserPass(const std::string& pass);
-        void SetHost(const std::string& host);
+        /**
+         * This method resolves a given relative reference, based on this
+         * URI, storing the resolved target URI in the given one.
+         * The storage the target already has is reused, so resolving
+         * many references into the same target allocates little.
+         *
+         * @param[in] relativeReference
+         *      This describe how to get to the target starting at the base.
+         * @param[out] target
+         *      This is where to store the resolved target URI.  It may
+         *      be this URI or the relative reference itself.  It keeps
+         *      its memory resource either way.
+         */
+        void ResolveInto(const Uri& relativeReference, Uri& target) const;
+
+        /**
+         * This method resolves a given relative reference string against
+         * a given base URI string, working on the encoded strings directly,
+         * without building any Uri.
+         *
+         * @note
+         *      The elements are copied as they are, without being checked,
+         *      decoded or normalized, so the result may differ in those
+         *      respects from what Resolve and GenerateString would give.
+         *
+         * @param[in] base
+         *      This is the base URI string, which must be absolute.
+         * @param[in] relativeReference
+         *      This describe how to get to the target starting at the base.
+         * @param[out] target
+         *      This is where to store the resolved target URI string.
+         *      Its previous contents are replaced, but its capacity is kept.
+         * @return
+         *      An indication of whether or not the reference was resolved
+         *      is returned.  It isn't if the delimiters of either string
+         *      are inconsistent or the base has no scheme.
+         */
+        static bool ResolveString(std::string_view base, std::string_view relativeReference,
+                                  std::string& target);
+
+        /**
+         * These methods set the "scheme" element of the URI.
+         *
+         * @note
+         *      Each setter taking a string comes in four forms: a view,
+         *      a pointer and length, a null-terminated string and an
+         *      expiring std::pmr::string.  The first three copy the
+         *      characters once, into storage from the memory resource
+         *      of the URI, so an std::string is passed as a view.
+         *      The last takes over the buffer of the string given, with
+         *      no copy, if the string uses the memory resource of the
+         *      URI (as both do by default), and copies it otherwise.
+         */
+        void SetScheme(std::string_view scheme);
+        void SetScheme(const char* scheme);
+        void SetScheme(const char* scheme, size_t length);
+        void SetScheme(std::pmr::string&& scheme);
+
+        /**
+         * These methods set the user name part of the user information element.
+         */
+        void SetUserName(std::string_view user);
+        void SetUserName(const char* user);
+        void SetUserName(const char* user, size_t length);
+        void SetUserName(std::pmr::string&& user);
+
+        /**
+         * These methods set the password part of the user information element.
+         */
+        void SetUserPass(std::string_view pass);
+        void SetUserPass(const char* pass);
+        void SetUserPass(const char* pass, size_t length);
+        void SetUserPass(std::pmr::string&& pass);
+
+        /**
+         * These methods set the "host" element of the URI.
+         * The kind of host is worked out from the host itself.  A host
+         * is only taken as an IPvFuture address if it holds a ":", since
+         * otherwise it may as well be a reg-name such as "v1.example".
+         */
+        void SetHost(std::string_view host);
+        void SetHost(const char* host);
+        void SetHost(const char* host, size_t length);
+        void SetHost(std::pmr::string&& host);
+
+        /**
+         * This method sets the "host" element of the URI, taking it
+         * as the given kind of host rather than working it out.
+         * This tells a reg-name apart from an IPvFuture address
+         * whose text is the same once decoded.
+         *
+         * @param[in] host
+         *      This is the host, decoded and without brackets.
+         * @param[in] kind
+         *      This is the kind of host it is.
+         * @return
+         *      An indication of whether or not the host is valid for
+         *      the given kind is returned.  If not, the URI is left
+         *      unchanged.  A reg-name may not be an IPv4 address.
+         */
+        bool SetHost(std::string_view host, HostKind kind);
+
         void SetPort(uint16_t port);
-        void SetQuery(const std::string& query);
-        void SetFragment(const std::string& fragment);
+
+        /**
+         * These methods set the "query" element of the URI,
+         * marking the URI as having a query.
+         */
+        void SetQuery(std::string_view query);
+        void SetQuery(const char* query);
+        void SetQuery(const char* query, size_t length);
+        void SetQuery(std::pmr::string&& query);
+
+        /**
+         * These methods set the "fragment" element of the URI,
+         * marking the URI as having a fragment.
+         */
+        void SetFragment(std::string_view fragment);
+        void SetFragment(const char* fragment);
+        void SetFragment(const char* fragment, size_t length);
+        void SetFragment(std::pmr::string&& fragment);
+
+        /**
+         * This method sets the "path" element of the URI,
+         * as a sequence of segments, which are copied into
+         * the single buffer holding the path.
+         *
+         * @note
+         *      There is no rvalue form, since the strings of a vector
+         *      can't become one buffer without being copied.  To change
+         *      a path in place, use AppendPathSegment, PopPathSegment,
+         *      ReplacePathSegment or TruncatePath instead.
+         */
         void SetPath(const std::vector<std::string>& path);
+
+        /**
+         * This method adds the given segment at the end of the "path"
+         * element of the URI, without copying the rest of the path.
+         *
+         * @param[in] segment
+         *      This is the segment to add, not percent-encoded.
+         */
+        void AppendPathSegment(std::string_view segment);
+
+        /**
+         * This method removes the last segment of the "path" element
+         * of the URI, if there is one.
+         */
+        void PopPathSegment();
+
+        /**
+         * This method replaces one segment of the "path" element
+         * of the URI, in place.
+         *
+         * @param[in] index
+         *      This is the index of the segment to replace.
+         * @param[in] segment
+         *      This is the new segment, not percent-encoded.
+         * @return
+         *      An indication of whether or not the path has a segment
+         *      at the given index is returned.  The path is left
+         *      unchanged if it doesn't.
+         */
+        bool ReplacePathSegment(size_t index, std::string_view segment);
+
+        /**
+         * This method removes every segment of the "path" element
+         * of the URI past the given number of segments.
+         *
+         * @param[in] count
+         *      This is the number of segments to keep.
+         */
+        void TruncatePath(size_t count);
+
+        /**
+         * This method renders the URI as a string, encoding each
+         * element as needed.  The string is allocated once, at its
+         * exact final size.
+         *
+         * @return
+         *      The string rendering of the URI is returned.
+         */
         std::string GenerateString() const;
+
+        /**
+         * This method renders the URI at the end of the given string,
+         * growing it once by exactly the length of the rendering.
+         *
+         * @param[in, out] buffer
+         *      This is the string to which to append the rendering.
+         */
+        void AppendTo(std::string& buffer) const;
+
+        /**
+         * This method renders the URI into the given character buffer.
+         * No null terminator is written.
+         *
+         * @param[out] buffer
+         *      This is where to write the rendering of the URI.
+         * @param[in] bufferSize
+         *      This is the number of characters the buffer can hold.
+         * @return
+         *      The length of the rendering is returned.  If it is larger
+         *      than the buffer size, nothing is written, so calling this
+         *      with a size of zero measures the rendering.
+         */
+        size_t WriteTo(char* buffer, size_t bufferSize) const;
+        // private methods
+    private:
+        /**
+         * The push parser hands over the elements it parsed
+         * through TakeElements.
+         */
+        friend class PushParser;
+
+        /**
+         * This method replaces every element of the URI with the
+         * given ones, taking over their storage where it can.
+         *
+         * @param[in, out] elements
+         *      These are the new elements of the URI.  They are
+         *      left with unspecified values.
+         */
+        void TakeElements(ParsedElements& elements);
+
+        /**
+         * A resolution base resolves references through the
+         * ResolveInto overload taking a merge prefix.
+         */
+        friend class ResolutionBase;
+
+        /**
+         * This method resolves a given relative reference, based on this
+         * URI, storing the resolved target URI in the given one.
+         *
+         * @param[in] relativeReference
+         *      This describe how to get to the target starting at the base.
+         * @param[out] target
+         *      This is where to store the resolved target URI.
+         *      It must not be this URI or the relative reference.
+         * @param[in] mergePrefix
+         *      If not null, this is the path of this URI without its
+         *      last segment, onto which a relative path is merged.
+         */
+        void ResolveInto(const Uri& relativeReference, Uri& target,
+                         const PathStorage* mergePrefix) const;
+
         // private properties
     private:
         /**
@@ -256,11 +870,61 @@ namespace Uri
          */
         struct Impl;
 
+        /**
+         * This destroys the private properties of the instance and
+         * gives their memory back to the memory resource of the URI.
+         */
+        struct ImplDeleter
+        {
+            void operator()(Impl* impl) const;
+        };
+
         /**
          * This contains the private properties of the instance.
          */
-        std::unique_ptr<struct Impl> impl_;
+        std::unique_ptr<struct Impl, ImplDeleter> impl_;
+    };
+
+    /**
+     * This is the hash function for URIs in unordered containers.
+     * It is transparent: a URI string hashes the same as the URI
+     * parsed from it, so that containers supporting heterogeneous
+     * lookup can be searched by string without building a URI.
+     * A string which can't be parsed hashes to zero.
+     */
+    struct UriHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(const Uri& uri) const;
+        size_t operator()(std::string_view uriString) const;
+    };
+
+    /**
+     * This is the equality function for URIs in unordered containers,
+     * matching UriHash.  A URI string is equal to a URI when the URI
+     * parsed from it is; a string which can't be parsed equals no URI.
+     */
+    struct UriEqual
+    {
+        using is_transparent = void;
+
+        bool operator()(const Uri& lhs, const Uri& rhs) const;
+        bool operator()(const Uri& lhs, std::string_view rhs) const;
+        bool operator()(std::string_view lhs, const Uri& rhs) const;
     };
 }  // namespace Uri
 
+/**
+ * This is the hash of a URI, for use by std::unordered_map
+ * and the like, which is the same as Uri::UriHash.
+ */
+namespace std
+{
+    template <> struct hash<Uri::Uri>
+    {
+        size_t operator()(const Uri::Uri& uri) const { return uri.GetHash(); }
+    };
+}  // namespace std
+
 #endif /*URI_HPP*/
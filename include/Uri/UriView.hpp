@@ -0,0 +1,168 @@
+#ifndef URI_URI_VIEW_HPP
+#define URI_URI_VIEW_HPP
+/**
+ * @file UriView.hpp
+ *
+ * This module contains the declaration of the Uri::UriView class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <stdint.h>
+#include <string>
+#include <string_view>
+
+namespace Uri
+{
+    /**
+     * This class is a non-owning, read-only view of a URI string.
+     *
+     * Parsing validates the whole string against RFC 3986, but every
+     * element is exposed in its encoded form as a view into the
+     * caller's buffer, which must outlive the view.  Percent-decoding
+     * only happens when a decoded element is asked for.
+     *
+     * @note
+     *      Unlike Uri::Uri, this class holds its properties directly,
+     *      so that constructing and parsing into it never touches the heap.
+     */
+    class UriView
+    {
+        // public methods
+    public:
+        /**
+         * This method locates and validates the elements of the
+         * given string rendering of a URI.
+         *
+         * @param[in] uriString
+         *      This is the string rendering of the URI to parse.
+         *      It must outlive the view.
+         * @return
+         *      whether or not the URI was parsed sucssefully is returnd.
+         */
+        bool Parse(std::string_view uriString);
+
+        /**
+         * This method returns the "scheme" element of the URI,
+         * as it appears in the URI string (case is not normalized).
+         *
+         * @retval ""
+         *      An empty view is returned if there is no "scheme" element in the URI.
+         */
+        std::string_view GetScheme() const { return scheme_; }
+
+        /**
+         * This methode returns an indication of whether or not
+         * the URI is a relative reference.
+         */
+        bool IsRelativeReference() const { return scheme_.empty(); }
+
+        /**
+         * This method returns an indication of whether or not the URI
+         * has an authority element (it starts with "//" after the scheme).
+         */
+        bool HasAuthority() const { return hasAuthority_; }
+
+        /**
+         * This method returns the encoded "userinfo" element of the URI,
+         * including the ":" delimiting the user name from the password.
+         */
+        std::string_view GetUserInfo() const { return userInfo_; }
+
+        /**
+         * This method returns the encoded "host" element of the URI.
+         * The brackets around an IP-literal are not included.
+         */
+        std::string_view GetHost() const { return host_; }
+
+        /**
+         * This method returns an indication of whether or not the URI
+         * includes a port number.
+         */
+        bool HasPort() const { return hasPort_; }
+
+        /**
+         * This method returns the port number of the URI.
+         *
+         * @note
+         *      The returned port number is only valid if the
+         *      HasPort method returns true.
+         */
+        uint16_t GetPort() const { return port_; }
+
+        /**
+         * This method returns the encoded "path" element of the URI.
+         */
+        std::string_view GetPath() const { return path_; }
+
+        /**
+         * This method returns an indication of whether or not the URI
+         * includes a query.
+         */
+        bool HasQuery() const { return hasQuery_; }
+
+        /**
+         * This method returns the encoded "query" element of the URI.
+         */
+        std::string_view GetQuery() const { return query_; }
+
+        /**
+         * This method returns an indication of whether or not the URI
+         * includes a fragment.
+         */
+        bool HasFragment() const { return hasFragment_; }
+
+        /**
+         * This method returns the encoded "fragment" element of the URI.
+         */
+        std::string_view GetFragment() const { return fragment_; }
+
+        /**
+         * This method returns the percent-decoded "userinfo" element of the URI.
+         */
+        std::string GetDecodedUserInfo() const;
+
+        /**
+         * This method returns the percent-decoded "host" element of the URI.
+         *
+         * @note
+         *      The case of the host is kept as it appears in the URI string.
+         */
+        std::string GetDecodedHost() const;
+
+        /**
+         * This method returns the percent-decoded "path" element of the URI.
+         *
+         * @note
+         *      An encoded "/" ("%2F") is decoded like any other character,
+         *      so the result can no longer be split into segments reliably.
+         */
+        std::string GetDecodedPath() const;
+
+        /**
+         * This method returns the percent-decoded "query" element of the URI.
+         */
+        std::string GetDecodedQuery() const;
+
+        /**
+         * This method returns the percent-decoded "fragment" element of the URI.
+         */
+        std::string GetDecodedFragment() const;
+
+        // private properties
+    private:
+        std::string_view scheme_;
+        std::string_view userInfo_;
+        std::string_view host_;
+        std::string_view path_;
+        std::string_view query_;
+        std::string_view fragment_;
+        uint16_t port_ = 0;
+        bool hasAuthority_ = false;
+        bool hasPort_ = false;
+        bool hasQuery_ = false;
+        bool hasFragment_ = false;
+    };
+}  // namespace Uri
+
+#endif /* URI_URI_VIEW_HPP */
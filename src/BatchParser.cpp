@@ -0,0 +1,261 @@
+/**
+ * @file BatchParser.cpp
+ *
+ * This module contains the implementation of the Uri::BatchParser class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <Uri/BatchParser.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string.h>
+#include <thread>
+
+namespace
+{
+    /**
+     * This is the number of strings each thread takes at a time.
+     * It is a multiple of 64, so that every word of the bitmap
+     * of results is only ever written by one thread.
+     */
+    constexpr size_t CHUNK_SIZE = 256;
+}  // namespace
+
+namespace Uri
+{
+    /**
+     * This contains the private properties of BatchParser instance.
+     */
+    struct BatchParser::Impl
+    {
+        /**
+         * These are the threads of the pool, not counting
+         * the thread calling the parser.
+         */
+        std::vector<std::thread> workers;
+
+        /**
+         * This is held while a batch is parsed, so that batches
+         * given from several threads are parsed one at a time.
+         */
+        std::mutex batchMutex;
+
+        /**
+         * This protects the state shared with the workers.
+         */
+        std::mutex mutex;
+
+        /**
+         * This is used to wake the workers when there is a
+         * new batch to parse, or when they should stop.
+         */
+        std::condition_variable workReady;
+
+        /**
+         * This is used to wake the calling thread when
+         * every worker is done with the batch.
+         */
+        std::condition_variable workDone;
+
+        /**
+         * This is counted up for every batch handed to the workers.
+         */
+        uint64_t generation = 0;
+
+        /**
+         * This is the number of workers still parsing the current batch.
+         */
+        size_t busyWorkers = 0;
+
+        /**
+         * This is an indication of whether or not the workers
+         * should stop.
+         */
+        bool stopping = false;
+
+        /**
+         * These are the URI strings of the current batch.
+         */
+        const std::string_view* inputs = nullptr;
+
+        /**
+         * This is the number of URI strings in the current batch.
+         */
+        size_t count = 0;
+
+        /**
+         * This is where the results of the current batch go.
+         */
+        BatchParseResults* results = nullptr;
+
+        /**
+         * This is the index of the next chunk of the current batch
+         * which no thread has taken yet.
+         */
+        std::atomic<size_t> nextChunk{0};
+
+        /**
+         * This is the number of URI strings of the current
+         * batch which were parsed successfully.
+         */
+        std::atomic<size_t> parsedCount{0};
+
+        /**
+         * These are the lines of the buffer given to ParseBatchLines,
+         * kept from one batch to the next so that splitting a buffer
+         * into lines allocates nothing once they have room enough.
+         */
+        std::vector<std::string_view> lineViews;
+
+        // Methods
+
+        /**
+         * This method parses every one of the given URI strings.
+         * The batch mutex must be held.
+         *
+         * @param[in] batchInputs
+         *      This points to the first of the URI strings to parse.
+         * @param[in] batchCount
+         *      This is the number of URI strings to parse.
+         * @param[in, out] batchResults
+         *      This is where to store the URIs parsed and which
+         *      of them were parsed successfully.
+         */
+        void ParseBatch(const std::string_view* batchInputs, size_t batchCount,
+                        BatchParseResults& batchResults) {
+            auto& uris = batchResults.uris;
+            if (uris.size() > batchCount)
+            { uris.erase(uris.begin() + batchCount, uris.end()); }
+            for (auto& uri : uris)
+            {
+                if (uri.GetMemoryResource() != batchResults.memoryResource)
+                { uri = Uri(batchResults.memoryResource); }
+            }
+            uris.reserve(batchCount);
+            while (uris.size() < batchCount)
+            { uris.emplace_back(batchResults.memoryResource); }
+            batchResults.parsed.assign((batchCount + 63) / 64, 0);
+            inputs = batchInputs;
+            count = batchCount;
+            results = &batchResults;
+            nextChunk.store(0, std::memory_order_relaxed);
+            parsedCount.store(0, std::memory_order_relaxed);
+            if (workers.empty() || (count <= CHUNK_SIZE))
+            {
+                ParseChunks();
+            } else
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    busyWorkers = workers.size();
+                    ++generation;
+                }
+                workReady.notify_all();
+                ParseChunks();
+                std::unique_lock<std::mutex> lock(mutex);
+                workDone.wait(lock, [this] { return busyWorkers == 0; });
+            }
+            batchResults.parsedCount = parsedCount.load(std::memory_order_relaxed);
+            results = nullptr;
+            inputs = nullptr;
+        }
+
+        /**
+         * This method takes chunks of the current batch and parses
+         * them, until there are none left.
+         */
+        void ParseChunks() {
+            size_t localParsedCount = 0;
+            for (;;)
+            {
+                const auto first = nextChunk.fetch_add(1, std::memory_order_relaxed) * CHUNK_SIZE;
+                if (first >= count)
+                { break; }
+                const auto last = std::min(first + CHUNK_SIZE, count);
+                for (size_t word = first; word < last; word += 64)
+                {
+                    uint64_t bits = 0;
+                    const auto wordEnd = std::min(word + 64, last);
+                    for (size_t i = word; i < wordEnd; ++i)
+                    {
+                        if (results->uris[i].ParseFromString(inputs[i]))
+                        {
+                            bits |= (uint64_t)1 << (i - word);
+                            ++localParsedCount;
+                        }
+                    }
+                    results->parsed[word / 64] = bits;
+                }
+            }
+            parsedCount.fetch_add(localParsedCount, std::memory_order_relaxed);
+        }
+
+        /**
+         * This method is the body of every worker thread.
+         */
+        void Work() {
+            uint64_t lastGeneration = 0;
+            std::unique_lock<std::mutex> lock(mutex);
+            for (;;)
+            {
+                workReady.wait(lock, [&] { return stopping || (generation != lastGeneration); });
+                if (stopping)
+                { return; }
+                lastGeneration = generation;
+                lock.unlock();
+                ParseChunks();
+                lock.lock();
+                if (--busyWorkers == 0)
+                { workDone.notify_one(); }
+            }
+        }
+    };
+
+    BatchParser::~BatchParser() {
+        {
+            std::lock_guard<std::mutex> lock(impl_->mutex);
+            impl_->stopping = true;
+        }
+        impl_->workReady.notify_all();
+        for (auto& worker : impl_->workers)
+        { worker.join(); }
+    }
+
+    BatchParser::BatchParser(size_t threadCount) : impl_(new Impl) {
+        if (threadCount == 0)
+        { threadCount = std::max(std::thread::hardware_concurrency(), 1u); }
+        impl_->workers.reserve(threadCount - 1);
+        for (size_t i = 1; i < threadCount; ++i)
+        { impl_->workers.emplace_back([this] { impl_->Work(); }); }
+    }
+
+    size_t BatchParser::GetThreadCount() const { return impl_->workers.size() + 1; }
+
+    void BatchParser::ParseBatch(const std::string_view* inputs, size_t count,
+                                 BatchParseResults& results) {
+        std::lock_guard<std::mutex> batchLock(impl_->batchMutex);
+        impl_->ParseBatch(inputs, count, results);
+    }
+
+    void BatchParser::ParseBatchLines(std::string_view lines, BatchParseResults& results) {
+        std::lock_guard<std::mutex> batchLock(impl_->batchMutex);
+        auto& lineViews = impl_->lineViews;
+        lineViews.clear();
+        size_t lineStart = 0;
+        while (lineStart < lines.length())
+        {
+            const auto newline =
+                (const char*)memchr(lines.data() + lineStart, '\n', lines.length() - lineStart);
+            auto lineEnd = (newline == nullptr) ? lines.length() : (size_t)(newline - lines.data());
+            const auto nextLineStart = lineEnd + 1;
+            if ((lineEnd > lineStart) && (lines[lineEnd - 1] == '\r'))
+            { --lineEnd; }
+            lineViews.push_back(lines.substr(lineStart, lineEnd - lineStart));
+            lineStart = nextLineStart;
+        }
+        impl_->ParseBatch(lineViews.data(), lineViews.size(), results);
+    }
+}  // namespace Uri
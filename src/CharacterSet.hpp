@@ -10,29 +10,30 @@
  */
 
 #include <initializer_list>
-#include <memory>
+#include <stdint.h>
+
 namespace Uri
 {
     /**
      * This represent à set of characters which can be quired
      * to look if a character is in the set or not.
+     *
+     * The set is a 256-bit bitmap, one bit per possible value
+     * of a char, so it can be built at compile time, copied
+     * freely, and queried without branching.
+     *
+     * Alongside the bitmap, the set keeps the same membership
+     * information split by nibble (see GetLowNibbleClasses), which
+     * is the form the vectorized span scanners look bytes up in.
      */
 
     class CharacterSet
     {
-        // Lifecycle management for the class
-    public:
-        ~CharacterSet();
-        CharacterSet(const CharacterSet&);
-        CharacterSet(CharacterSet&&);
-        CharacterSet& operator=(const CharacterSet&);
-        CharacterSet& operator=(CharacterSet&&);
-
     public:
         /**
          * This is the default constructor.
          */
-        CharacterSet();
+        constexpr CharacterSet() = default;
 
         /**
          * This is the constructer of a character set
@@ -41,7 +42,11 @@ namespace Uri
          * @param[in] c
          *      The character of the set
          */
-        CharacterSet(char c);
+        constexpr CharacterSet(char c) {
+            Insert(c);
+            BuildNibbleClasses();
+        }
+
         /**
          * This is th constracter of all the characters between
          * the given "first" and "last" characters, inclusive.
@@ -52,7 +57,11 @@ namespace Uri
          * @param[in] last
          *      The last character of the set.
          */
-        CharacterSet(char first, char last);
+        constexpr CharacterSet(char first, char last) {
+            for (int c = (unsigned char)first; c <= (int)(unsigned char)last; ++c)
+            { Insert((char)c); }
+            BuildNibbleClasses();
+        }
 
         /**
          * This is th constracter of all the characters in several
@@ -63,7 +72,14 @@ namespace Uri
          *
          *
          */
-        CharacterSet(std::initializer_list<const CharacterSet> characterSets);
+        constexpr CharacterSet(std::initializer_list<const CharacterSet> characterSets) {
+            for (const auto& characterSet : characterSets)
+            {
+                for (int word = 0; word < 4; ++word)
+                { bits_[word] |= characterSet.bits_[word]; }
+            }
+            BuildNibbleClasses();
+        }
 
         /**
          * This method check if a given character is in the set
@@ -75,21 +91,87 @@ namespace Uri
          * @return
          *      return an indication of whether or not the character is on the set.
          */
+        constexpr bool Contains(char c) const {
+            const auto value = (unsigned char)c;
+            return ((bits_[value >> 6] >> (value & 63)) & 1) != 0;
+        }
+
+        /**
+         * This method returns an indication of whether or not every
+         * character in the set is an ASCII character (below 0x80).
+         *
+         * @return
+         *      true if the set only holds ASCII characters, else false.
+         */
+        constexpr bool IsAscii() const { return (bits_[2] | bits_[3]) == 0; }
+
+        /**
+         * This method returns the table of character classes indexed
+         * by the low nibble of a character.  Entry "l" has bit "h" set
+         * if the ASCII character (h << 4) | l is in the set.
+         *
+         * @note
+         *      Together with GetHighNibbleClasses, this means an ASCII
+         *      character c is in the set exactly when
+         *      (low[c & 0x0F] & high[c >> 4]) is not zero.
+         *
+         * @return
+         *      The 16-entry table of low nibble classes is returned.
+         */
+        constexpr const uint8_t* GetLowNibbleClasses() const { return lowNibbleClasses_; }
 
-        bool Contains(char c) const;
+        /**
+         * This method returns the table of character classes indexed
+         * by the high nibble of a character.  Entry "h" is (1 << h)
+         * for the eight ASCII high nibbles, and zero for the others.
+         *
+         * @return
+         *      The 16-entry table of high nibble classes is returned.
+         */
+        constexpr const uint8_t* GetHighNibbleClasses() const { return highNibbleClasses_; }
 
     private:
         /**
-         * This is the type of structure that contains the private
-         * properties of the instance. It is defined in the implementation
-         * and declared here to ensure that iwt is scoped inside the class.
+         * This method adds the given character to the set.
+         *
+         * @param[in] c
+         *      This is the character to add.
+         */
+        constexpr void Insert(char c) {
+            const auto value = (unsigned char)c;
+            bits_[value >> 6] |= (uint64_t)1 << (value & 63);
+        }
+
+        /**
+         * This method rebuilds the nibble class tables from the bitmap.
+         */
+        constexpr void BuildNibbleClasses() {
+            for (int low = 0; low < 16; ++low)
+            {
+                lowNibbleClasses_[low] = 0;
+                for (int high = 0; high < 8; ++high)
+                {
+                    if (Contains((char)((high << 4) | low)))
+                    { lowNibbleClasses_[low] |= (uint8_t)(1 << high); }
+                }
+            }
+        }
+
+        /**
+         * This is the bitmap of the characters in the set, where
+         * bit (c % 64) of word (c / 64) is set if c is in the set.
+         */
+        uint64_t bits_[4] = {0, 0, 0, 0};
+
+        /**
+         * This is the table of character classes indexed by low nibble.
          */
-        struct Impl;
+        uint8_t lowNibbleClasses_[16] = {};
 
         /**
-         * This contains the private properties of the instance.
+         * This is the table of character classes indexed by high nibble.
          */
-        std::unique_ptr<struct Impl> impl_;
+        uint8_t highNibbleClasses_[16] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
     };
 
 }  // namespace Uri
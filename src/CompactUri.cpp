@@ -0,0 +1,196 @@
+/**
+ * @file CompactUri.cpp
+ *
+ * This module contains the implementation of the Uri::CompactUri class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "UriComponents.hpp"
+#include <Uri/CompactUri.hpp>
+#include <limits>
+#include <stdexcept>
+#include <string.h>
+#include <string>
+
+namespace
+{
+    /**
+     * This function mixes the given value into the given hash.
+     */
+    size_t CombineHash(size_t hash, size_t value) {
+        return hash ^ (value + (size_t)0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2));
+    }
+}  // namespace
+
+namespace Uri
+{
+    CompactUri::~CompactUri() { Release(); }
+
+    CompactUri::CompactUri(const CompactUri& other)
+        : storage_(other.storage_), segmentCount_(other.segmentCount_), port_(other.port_),
+          flags_(other.flags_) {
+        memcpy(ends_, other.ends_, sizeof(ends_));
+        CopyBlock(other);
+    }
+
+    CompactUri::CompactUri(CompactUri&& other) noexcept
+        : storage_(other.storage_), segmentCount_(other.segmentCount_), port_(other.port_),
+          flags_(other.flags_) {
+        memcpy(ends_, other.ends_, sizeof(ends_));
+        other.storage_ = Storage{};
+        memset(other.ends_, 0, sizeof(other.ends_));
+        other.segmentCount_ = 0;
+        other.port_ = 0;
+        other.flags_ = 0;
+    }
+
+    CompactUri& CompactUri::operator=(const CompactUri& other) {
+        if (this != &other)
+        { *this = CompactUri(other); }
+        return *this;
+    }
+
+    CompactUri& CompactUri::operator=(CompactUri&& other) noexcept {
+        if (this != &other)
+        {
+            Release();
+            storage_ = other.storage_;
+            memcpy(ends_, other.ends_, sizeof(ends_));
+            segmentCount_ = other.segmentCount_;
+            port_ = other.port_;
+            flags_ = other.flags_;
+            other.storage_ = Storage{};
+            memset(other.ends_, 0, sizeof(other.ends_));
+            other.segmentCount_ = 0;
+            other.port_ = 0;
+            other.flags_ = 0;
+        }
+        return *this;
+    }
+
+    CompactUri::CompactUri(const Uri& uri) {
+        const auto segments = uri.GetPathSegments();
+        size_t pathLength = segments.empty() ? 0 : (segments.size() - 1);
+        for (const auto segment : segments)
+        { pathLength += segment.length(); }
+
+        // An IPv6 host is packed in its canonical text, since two Uri
+        // objects with the same address are equal however it was written.
+        char ipv6Text[IPV6_TEXT_SIZE];
+        const auto address = uri.GetHostAddress();
+        const auto host = (address.family == AddressFamily::IPv6)
+                              ? FormatIPv6Address(address.ipv6, ipv6Text)
+                              : uri.GetHostView();
+        const std::string_view elements[ELEMENT_COUNT] = {
+            uri.GetSchemeView(), uri.GetUserNameView(),
+            uri.GetUserPassView(), host,
+            std::string_view(),  uri.HasQuery() ? uri.GetQueryView() : std::string_view(),
+            uri.HasFragment() ? uri.GetFragmentView() : std::string_view()};
+        size_t end = 0;
+        for (size_t i = 0; i < ELEMENT_COUNT; ++i)
+        {
+            end += ((i == PATH) ? pathLength : elements[i].length());
+            if (end + segments.size() * sizeof(uint32_t) > std::numeric_limits<uint32_t>::max())
+            { throw std::length_error("URI too long to pack"); }
+            ends_[i] = (uint32_t)end;
+        }
+        segmentCount_ = (uint32_t)segments.size();
+        if (uri.HasPort())
+        {
+            flags_ |= HAS_PORT;
+            port_ = uri.GetPort();
+        }
+        if (uri.HasQuery())
+        { flags_ |= HAS_QUERY; }
+        if (uri.HasFragment())
+        { flags_ |= HAS_FRAGMENT; }
+        flags_ |= (uint8_t)((uint8_t)uri.GetHostKind() << HOST_KIND_SHIFT);
+
+        uint32_t* words = storage_.inlineWords;
+        if (!IsInline())
+        {
+            storage_.heap = new uint32_t[GetWordCount()];
+            words = storage_.heap;
+        }
+        auto text = (char*)(words + segmentCount_);
+        for (size_t i = 0; i < ELEMENT_COUNT; ++i)
+        {
+            const auto start = (i == SCHEME) ? 0 : ends_[i - 1];
+            if (i != PATH)
+            {
+                // Absent elements are empty views, whose data may be null.
+                if (!elements[i].empty())
+                { memcpy(text + start, elements[i].data(), elements[i].length()); }
+                continue;
+            }
+            uint32_t segmentEnd = 0;
+            for (size_t segmentIndex = 0; segmentIndex < segments.size(); ++segmentIndex)
+            {
+                if (segmentIndex > 0)
+                { text[start + segmentEnd++] = '/'; }
+                const auto segment = segments[segmentIndex];
+                memcpy(text + start + segmentEnd, segment.data(), segment.length());
+                segmentEnd += (uint32_t)segment.length();
+                words[segmentIndex] = segmentEnd;
+            }
+        }
+    }
+
+    bool CompactUri::ParseFromString(std::string_view uriString) {
+        thread_local Uri scratch;
+        if (!scratch.ParseFromString(uriString))
+        { return false; }
+        *this = CompactUri(scratch);
+        return true;
+    }
+
+    Uri CompactUri::ToUri() const {
+        Uri uri;
+        uri.SetScheme(GetScheme());
+        uri.SetUserName(GetUserName());
+        uri.SetUserPass(GetUserPass());
+        (void)uri.SetHost(GetHost(), GetHostKind());
+        if (HasPort())
+        { uri.SetPort(port_); }
+        for (const auto segment : GetPathSegments())
+        { uri.AppendPathSegment(segment); }
+        if (HasQuery())
+        { uri.SetQuery(GetQuery()); }
+        if (HasFragment())
+        { uri.SetFragment(GetFragment()); }
+        return uri;
+    }
+
+    bool CompactUri::operator==(const CompactUri& other) const {
+        // The header is compared first, since it settles most
+        // unequal pairs without touching the blocks.
+        if ((flags_ != other.flags_) || (segmentCount_ != other.segmentCount_) ||
+            (port_ != other.port_) ||
+            (memcmp(ends_, other.ends_, sizeof(ends_)) != 0))
+        { return false; }
+        return (memcmp(GetWords(), other.GetWords(), GetBlockSize()) == 0);
+    }
+
+    size_t CompactUri::GetHash() const {
+        size_t hash = std::hash<std::string_view>()(
+            std::string_view((const char*)GetWords(), GetBlockSize()));
+        hash = CombineHash(hash, flags_);
+        hash = CombineHash(hash, HasPort() ? port_ : 0);
+        for (const auto end : ends_)
+        { hash = CombineHash(hash, end); }
+        return hash;
+    }
+
+    void CompactUri::Release() {
+        if (!IsInline())
+        { delete[] storage_.heap; }
+    }
+
+    void CompactUri::CopyBlock(const CompactUri& other) {
+        if (IsInline())
+        { return; }
+        storage_.heap = new uint32_t[GetWordCount()];
+        memcpy(storage_.heap, other.storage_.heap, GetBlockSize());
+    }
+}  // namespace Uri
@@ -0,0 +1,246 @@
+/**
+ * @file ParseCache.cpp
+ *
+ * This module contains the implementation of the Uri::ParseCache class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <Uri/ParseCache.hpp>
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    /**
+     * This is the key of the index of a shard: a view of a URI
+     * string along with its hash, so that the string is only
+     * hashed once per lookup.
+     */
+    struct CacheKey
+    {
+        std::string_view text;
+        size_t hash = 0;
+
+        bool operator==(const CacheKey& other) const { return text == other.text; }
+    };
+
+    /**
+     * This is the hash function of the index of a shard,
+     * which hands back the hash stored in the key.
+     */
+    struct CacheKeyHash
+    {
+        size_t operator()(const CacheKey& key) const { return key.hash; }
+    };
+
+    /**
+     * This holds one URI in a shard.
+     */
+    struct Slot
+    {
+        /**
+         * This is the URI string the URI was parsed from.
+         * The key of the slot in the index of the shard is a view of it.
+         */
+        std::string text;
+
+        /**
+         * This is the hash of the URI string.
+         */
+        size_t hash = 0;
+
+        /**
+         * This is the URI parsed from the string.
+         */
+        std::shared_ptr<const Uri::Uri> uri;
+
+        /**
+         * This is an indication of whether or not the URI was found
+         * since the clock hand last passed the slot.
+         */
+        bool referenced = false;
+    };
+
+    /**
+     * This is one independently locked part of the cache.  It is
+     * aligned so that no two shards share a cache line.
+     */
+    struct alignas(64) Shard
+    {
+        std::mutex mutex;
+        std::vector<Slot> slots;
+        std::unordered_map<CacheKey, size_t, CacheKeyHash> index;
+        size_t capacity = 0;
+        size_t hand = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+}  // namespace
+
+namespace Uri
+{
+    /**
+     * This contains the private properties of ParseCache instance.
+     */
+    struct ParseCache::Impl
+    {
+        /**
+         * These are the shards of the cache.
+         */
+        std::unique_ptr<Shard[]> shards;
+
+        /**
+         * This is the number of shards of the cache.
+         */
+        size_t shardCount = 0;
+
+        // Methods
+
+        /**
+         * This method returns the shard holding the URI strings
+         * with the given hash.
+         *
+         * @param[in] hash
+         *      This is the hash of the URI string.
+         * @return
+         *      The shard holding the URI strings with the given
+         *      hash is returned.
+         */
+        Shard& GetShard(size_t hash) {
+            // The index of each shard picks buckets from the low bits
+            // of the hash, so the shard is picked from the high bits.
+            return shards[(hash >> (sizeof(size_t) * 4)) % shardCount];
+        }
+
+        /**
+         * This method picks the slot of the given shard in which
+         * to put a new URI, dropping the URI it held if any.
+         *
+         * @param[in, out] shard
+         *      This is the shard in which to find a slot.
+         * @return
+         *      The index of the slot is returned.
+         */
+        static size_t TakeSlot(Shard& shard) {
+            if (shard.slots.size() < shard.capacity)
+            {
+                shard.slots.emplace_back();
+                return shard.slots.size() - 1;
+            }
+            while (shard.slots[shard.hand].referenced)
+            {
+                shard.slots[shard.hand].referenced = false;
+                shard.hand = (shard.hand + 1) % shard.capacity;
+            }
+            const auto slotIndex = shard.hand;
+            shard.hand = (shard.hand + 1) % shard.capacity;
+            auto& slot = shard.slots[slotIndex];
+            shard.index.erase(CacheKey{slot.text, slot.hash});
+            slot.uri.reset();
+            ++shard.evictions;
+            return slotIndex;
+        }
+    };
+
+    ParseCache::~ParseCache() = default;
+
+    ParseCache::ParseCache(size_t capacity, size_t shardCount) : impl_(new Impl) {
+        impl_->shardCount = std::max(shardCount, (size_t)1);
+        impl_->shards.reset(new Shard[impl_->shardCount]);
+        const auto shardCapacity =
+            std::max((capacity + impl_->shardCount - 1) / impl_->shardCount, (size_t)1);
+        for (size_t i = 0; i < impl_->shardCount; ++i)
+        {
+            auto& shard = impl_->shards[i];
+            shard.capacity = shardCapacity;
+            // The slots must never move, since the index
+            // holds views of the strings in them.
+            shard.slots.reserve(shardCapacity);
+            shard.index.reserve(shardCapacity);
+        }
+    }
+
+    std::shared_ptr<const Uri> ParseCache::Parse(std::string_view uriString) {
+        const auto hash = std::hash<std::string_view>()(uriString);
+        auto& shard = impl_->GetShard(hash);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            const auto entry = shard.index.find(CacheKey{uriString, hash});
+            if (entry != shard.index.end())
+            {
+                auto& slot = shard.slots[entry->second];
+                slot.referenced = true;
+                ++shard.hits;
+                return slot.uri;
+            }
+            ++shard.misses;
+        }
+
+        // Parse without holding the lock, and work out everything
+        // which is otherwise worked out lazily, since the URI is
+        // about to be shared between threads.  Parsing lazily keeps
+        // the encoded form of every element, and the hash decodes
+        // every element, so neither is left to work out.
+        auto uri = std::make_shared<Uri>();
+        if (!uri->ParseFromString(uriString, Decoding::Lazy))
+        { return nullptr; }
+        (void)uri->GetPathSegments();
+        (void)uri->GetHash();
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const auto entry = shard.index.find(CacheKey{uriString, hash});
+        if (entry != shard.index.end())
+        {
+            // Another thread added the same string in the meantime.
+            return shard.slots[entry->second].uri;
+        }
+        const auto slotIndex = Impl::TakeSlot(shard);
+        auto& slot = shard.slots[slotIndex];
+        slot.text.assign(uriString);
+        slot.hash = hash;
+        slot.uri = std::move(uri);
+        slot.referenced = false;
+        shard.index.emplace(CacheKey{slot.text, hash}, slotIndex);
+        return slot.uri;
+    }
+
+    size_t ParseCache::GetSize() const {
+        size_t size = 0;
+        for (size_t i = 0; i < impl_->shardCount; ++i)
+        {
+            auto& shard = impl_->shards[i];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            size += shard.index.size();
+        }
+        return size;
+    }
+
+    ParseCacheStatistics ParseCache::GetStatistics() const {
+        ParseCacheStatistics statistics;
+        for (size_t i = 0; i < impl_->shardCount; ++i)
+        {
+            auto& shard = impl_->shards[i];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            statistics.hits += shard.hits;
+            statistics.misses += shard.misses;
+            statistics.evictions += shard.evictions;
+        }
+        return statistics;
+    }
+
+    void ParseCache::Clear() {
+        for (size_t i = 0; i < impl_->shardCount; ++i)
+        {
+            auto& shard = impl_->shards[i];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.index.clear();
+            shard.slots.clear();
+            shard.hand = 0;
+        }
+    }
+}  // namespace Uri
@@ -0,0 +1,90 @@
+#ifndef URI_PARSED_ELEMENTS_HPP
+#define URI_PARSED_ELEMENTS_HPP
+
+/**
+ * @file ParsedElements.hpp
+ *
+ * This module declares the Uri::ParsedElements structure.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "PathStorage.hpp"
+#include <Uri/Uri.hpp>
+#include <memory_resource>
+#include <stdint.h>
+#include <string>
+
+namespace Uri
+{
+    /**
+     * This holds the decoded elements of a URI built up outside
+     * of a Uri, such as by a push parser, for a Uri to take over.
+     */
+    struct ParsedElements
+    {
+        // Methods
+
+        /**
+         * This method empties every element, keeping the storage
+         * allocated for them.
+         */
+        void Clear() {
+            scheme.clear();
+            userName.clear();
+            userPass.clear();
+            host.clear();
+            hostKind = HostKind::RegName;
+            hostAddress = HostAddress();
+            path.Clear();
+            query.clear();
+            rawQuery.clear();
+            fragment.clear();
+            port = 0;
+            hasPort = false;
+            hasQuery = false;
+            hasFragment = false;
+        }
+
+        // Properties
+
+        /**
+         * These are the decoded elements of the URI.
+         */
+        std::pmr::string scheme;
+        std::pmr::string userName;
+        std::pmr::string userPass;
+        std::pmr::string host;
+        PathStorage path;
+        std::pmr::string query;
+        std::pmr::string fragment;
+
+        /**
+         * This is the query as it appeared in the URI string,
+         * still percent-encoded.
+         */
+        std::pmr::string rawQuery;
+
+        /**
+         * This is the kind of the host, and its numeric form
+         * if it is an IP address.
+         */
+        HostKind hostKind = HostKind::RegName;
+        HostAddress hostAddress;
+
+        /**
+         * This is the port number of the URI, if it has one.
+         */
+        uint16_t port = 0;
+
+        /**
+         * These indicate whether or not the URI has a port number,
+         * a query and a fragment.
+         */
+        bool hasPort = false;
+        bool hasQuery = false;
+        bool hasFragment = false;
+    };
+}  // namespace Uri
+
+#endif /* URI_PARSED_ELEMENTS_HPP */
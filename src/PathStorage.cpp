@@ -0,0 +1,264 @@
+/**
+ * @file PathStorage.cpp
+ *
+ * This module contains the implementation of the Uri::PathStorage class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "PathStorage.hpp"
+
+#include <algorithm>
+#include <string.h>
+
+namespace
+{
+    /**
+     * This function checks whether or not the given encoded path
+     * holds a percent-encoded "/", which decodes to a character
+     * that is not a separator.
+     *
+     * @param[in] encodedPath
+     *      This is the encoded path to check.
+     * @return
+     *      An indication of whether or not the path holds
+     *      a percent-encoded "/" is returned.
+     */
+    bool ContainsEncodedSlash(std::string_view encodedPath) {
+        auto position = encodedPath.find('%');
+        while ((position != std::string_view::npos) && (position + 2 < encodedPath.length()))
+        {
+            if ((encodedPath[position + 1] == '2') &&
+                ((encodedPath[position + 2] == 'F') || (encodedPath[position + 2] == 'f')))
+            { return true; }
+            position = encodedPath.find('%', position + 1);
+        }
+        return false;
+    }
+}  // namespace
+
+namespace Uri
+{
+    bool NeedsDotSegmentRemoval(std::string_view path) {
+        bool previousEmpty = false;
+        size_t segmentStart = 0;
+        for (;;)
+        {
+            const auto delimiter = path.find('/', segmentStart);
+            const auto segment = path.substr(segmentStart, delimiter - segmentStart);
+            if ((segment == ".") || (segment == "..") || (segment.empty() && previousEmpty))
+            { return true; }
+            if (delimiter == std::string_view::npos)
+            { return false; }
+            previousEmpty = segment.empty();
+            segmentStart = delimiter + 1;
+        }
+    }
+
+    void PathStorage::Clear() {
+        buffer_.clear();
+        segmentEnds_.clear();
+        segmentCount_ = 0;
+        separatorInSegment_ = false;
+    }
+
+    bool PathStorage::Parse(std::string_view encodedPath) {
+        Clear();
+        if (encodedPath.length() > UINT32_MAX)
+        { return false; }
+        if (encodedPath.empty())
+        { return true; }
+        if (encodedPath == "/")
+        {
+            // Special case of an empty path.
+            segmentCount_ = 1;
+            segmentEnds_.push_back(0);
+            return true;
+        }
+        segmentCount_ = (size_t)std::count(encodedPath.begin(), encodedPath.end(), '/') + 1;
+        segmentEnds_.reserve(segmentCount_);
+        if (!ContainsEncodedSlash(encodedPath))
+        {
+            // Every "/" left after decoding is a separator,
+            // so the whole path is decoded in one go.
+            if (!AppendDecodedElement(encodedPath, PATH_CHAR_NOT_PCT_ENCODED, buffer_))
+            { return false; }
+            FindSegmentEnds();
+            return true;
+        }
+        separatorInSegment_ = true;
+        size_t segmentStart = 0;
+        for (;;)
+        {
+            const auto delimiter = encodedPath.find('/', segmentStart);
+            if (!AppendDecodedElement(encodedPath.substr(segmentStart, delimiter - segmentStart),
+                                      PCHAR_NOT_PCT_ENCODED, buffer_))
+            { return false; }
+            segmentEnds_.push_back((uint32_t)buffer_.length());
+            if (delimiter == std::string_view::npos)
+            { break; }
+            buffer_.push_back('/');
+            segmentStart = delimiter + 1;
+        }
+        return true;
+    }
+
+    void PathStorage::Assign(const std::vector<std::string>& segments) {
+        Clear();
+        for (const auto& segment : segments)
+        { AppendSegment(segment); }
+    }
+
+    void PathStorage::AppendSegment(std::string_view segment) {
+        if (segment.find('/') != std::string_view::npos)
+        { separatorInSegment_ = true; }
+        if (segmentCount_ > 0)
+        { buffer_.push_back('/'); }
+        buffer_.append(segment);
+        ++segmentCount_;
+        segmentEnds_.push_back((uint32_t)buffer_.length());
+    }
+
+    void PathStorage::PopSegment() {
+        if (segmentCount_ == 1)
+        {
+            Clear();
+            return;
+        }
+        --segmentCount_;
+        segmentEnds_.pop_back();
+        buffer_.resize(segmentEnds_.back());
+    }
+
+    void PathStorage::ReplaceSegment(size_t index, std::string_view segment) {
+        if (segment.find('/') != std::string_view::npos)
+        { separatorInSegment_ = true; }
+        const size_t start = (index == 0) ? 0 : (segmentEnds_[index - 1] + 1);
+        const size_t oldLength = segmentEnds_[index] - start;
+        (void)buffer_.replace(start, oldLength, segment);
+        const auto newEnd = (uint32_t)(start + segment.length());
+        // The shift wraps around if the segment gets shorter,
+        // which the unsigned additions below undo.
+        const auto shift = newEnd - segmentEnds_[index];
+        for (size_t i = index; i < segmentCount_; ++i)
+        { segmentEnds_[i] += shift; }
+    }
+
+    void PathStorage::Truncate(size_t count) {
+        if (count >= segmentCount_)
+        { return; }
+        if (count == 0)
+        {
+            Clear();
+            return;
+        }
+        buffer_.resize(segmentEnds_[count - 1]);
+        segmentEnds_.resize(count);
+        segmentCount_ = count;
+    }
+
+    bool PathStorage::RemoveDotSegments() {
+        if (separatorInSegment_ ? (segmentCount_ == 0) : !NeedsDotSegmentRemoval(buffer_))
+        { return false; }
+
+        // Each segment kept is moved down to the end of the ones kept
+        // before it, which never lies past its own start, and its end
+        // is written over an offset which was already read.
+        const auto inputCount = segmentCount_;
+        size_t outputCount = 0;
+        size_t written = 0;
+        size_t segmentStart = 0;
+        bool atDirectoryLevel = false;
+        bool changed = false;
+        for (size_t i = 0; i < inputCount; ++i)
+        {
+            const size_t segmentEnd = segmentEnds_[i];
+            const std::string_view segment(buffer_.data() + segmentStart,
+                                           segmentEnd - segmentStart);
+            segmentStart = segmentEnd + 1;
+            if ((segment == ".") || (segment == ".."))
+            {
+                // Remove last path element
+                // if we can navigate up a level.
+                if ((segment.length() == 2) && (outputCount > 0) &&
+                    ((segmentEnds_[0] > 0) || (outputCount > 1)))
+                {
+                    --outputCount;
+                    written = (outputCount == 0) ? 0 : segmentEnds_[outputCount - 1];
+                }
+                atDirectoryLevel = true;
+                changed = true;
+            } else
+            {
+                // An empty segment marks a transition to a directory
+                // level context, which is ignored if already in one.
+                if (!atDirectoryLevel || !segment.empty())
+                {
+                    if (outputCount > 0)
+                    { buffer_[written++] = '/'; }
+                    memmove(&buffer_[written], segment.data(), segment.length());
+                    written += segment.length();
+                    segmentEnds_[outputCount++] = (uint32_t)written;
+                } else
+                { changed = true; }
+                atDirectoryLevel = segment.empty();
+            }
+        }
+
+        // If at the end we're in a directory level context,
+        // add an empty segment to mark the fact.
+        if (atDirectoryLevel && (outputCount > 0))
+        {
+            const size_t lastStart = (outputCount == 1) ? 0 : (segmentEnds_[outputCount - 2] + 1);
+            if (segmentEnds_[outputCount - 1] > lastStart)
+            {
+                buffer_[written++] = '/';
+                segmentEnds_[outputCount++] = (uint32_t)written;
+            }
+        }
+        if (outputCount == 0)
+        {
+            Clear();
+        } else
+        {
+            buffer_.resize(written);
+            segmentEnds_.resize(outputCount);
+            segmentCount_ = outputCount;
+        }
+        return changed;
+    }
+
+    std::string_view PathStorage::GetFirstSegment() const {
+        return std::string_view(buffer_.data(), segmentEnds_[0]);
+    }
+
+    std::string_view PathStorage::GetLastSegment() const { return GetSegments().back(); }
+
+    PathSegments PathStorage::GetSegments() const {
+        return PathSegments(buffer_, segmentEnds_.data(), segmentCount_);
+    }
+
+    std::vector<std::string> PathStorage::ToVector() const {
+        std::vector<std::string> segments;
+        segments.reserve(segmentCount_);
+        for (const auto segment : GetSegments())
+        { segments.emplace_back(segment); }
+        return segments;
+    }
+
+    bool PathStorage::operator==(const PathStorage& other) const {
+        if ((segmentCount_ != other.segmentCount_) || (buffer_ != other.buffer_))
+        { return false; }
+        if (!separatorInSegment_ && !other.separatorInSegment_)
+        { return true; }
+        return (segmentEnds_ == other.segmentEnds_);
+    }
+
+    void PathStorage::FindSegmentEnds() {
+        segmentEnds_.clear();
+        size_t end = 0;
+        while ((end = buffer_.find('/', end)) != std::string::npos)
+        { segmentEnds_.push_back((uint32_t)end++); }
+        segmentEnds_.push_back((uint32_t)buffer_.length());
+    }
+}  // namespace Uri
@@ -0,0 +1,241 @@
+#ifndef URI_PATH_STORAGE_HPP
+#define URI_PATH_STORAGE_HPP
+
+/**
+ * @file PathStorage.hpp
+ *
+ * This module declares the Uri::PathStorage class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "UriComponents.hpp"
+#include <Uri/PathSegments.hpp>
+#include <memory_resource>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Uri
+{
+    /**
+     * This function tells whether or not removing dot segments could
+     * change the given path, which is either encoded or the buffer
+     * of a PathStorage.  It looks for "." and ".." segments, and for
+     * empty segments following each other, which are merged.
+     *
+     * @param[in] path
+     *      This is the path to check, its segments separated by "/".
+     * @return
+     *      An indication of whether or not removing dot segments
+     *      could change the path is returned.
+     */
+    bool NeedsDotSegmentRemoval(std::string_view path);
+
+    /**
+     * This class holds the decoded segments of the path of a URI
+     * in one buffer, each segment separated from the next by a "/",
+     * along with the offset of the end of each segment.
+     *
+     * The offsets are kept up to date by every method which changes
+     * the path, so looking up segments never changes the object and
+     * may be done from several threads at once.
+     */
+    class PathStorage
+    {
+        // Methods
+    public:
+        /**
+         * This constructs an empty path.
+         *
+         * @param[in] resource
+         *      This is the memory resource from which to allocate
+         *      the storage of the path.
+         */
+        explicit PathStorage(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : buffer_(resource), segmentEnds_(resource) {}
+
+        /**
+         * This method removes every segment, keeping the storage
+         * allocated for them.
+         */
+        void Clear();
+
+        /**
+         * This method replaces the segments with those of the
+         * given encoded path, decoding each one.
+         *
+         * @param[in] encodedPath
+         *      This is the whole path element of a URI string.
+         * @return
+         *      An indication if the path was parsed correctly or not
+         *      is returned.
+         */
+        bool Parse(std::string_view encodedPath);
+
+        /**
+         * This method replaces the segments with the given ones.
+         *
+         * @param[in] segments
+         *      These are the new segments of the path.
+         */
+        void Assign(const std::vector<std::string>& segments);
+
+        /**
+         * This method adds the given segment at the end of the path.
+         *
+         * @param[in] segment
+         *      This is the segment to add.
+         */
+        void AppendSegment(std::string_view segment);
+
+        /**
+         * This method removes the last segment of the path,
+         * which must not be empty.
+         */
+        void PopSegment();
+
+        /**
+         * This method replaces the segment at the given index,
+         * which must be less than the number of segments.
+         *
+         * @param[in] index
+         *      This is the index of the segment to replace.
+         * @param[in] segment
+         *      This is the new segment.
+         */
+        void ReplaceSegment(size_t index, std::string_view segment);
+
+        /**
+         * This method removes every segment past the given number
+         * of segments, keeping the storage allocated for them.
+         *
+         * @param[in] count
+         *      This is the number of segments to keep.
+         */
+        void Truncate(size_t count);
+
+        /**
+         * This method applies the "remove_dot_segments" routine of
+         * RFC 3986 to the path, moving the segments kept down the
+         * buffer in place, so that nothing is allocated.
+         *
+         * @return
+         *      An indication of whether or not the path was changed
+         *      is returned.
+         */
+        bool RemoveDotSegments();
+
+        /**
+         * This method returns the number of segments in the path.
+         */
+        size_t GetSegmentCount() const { return segmentCount_; }
+
+        /**
+         * This method returns an indication of whether or not
+         * the path has no segments at all.
+         */
+        bool IsEmpty() const { return segmentCount_ == 0; }
+
+        /**
+         * This method returns the buffer holding every segment,
+         * separated by "/" characters.
+         */
+        std::string_view GetBuffer() const { return buffer_; }
+
+        /**
+         * This method returns the first segment of the path,
+         * which must not be empty.
+         */
+        std::string_view GetFirstSegment() const;
+
+        /**
+         * This method returns the last segment of the path,
+         * which must not be empty.
+         */
+        std::string_view GetLastSegment() const;
+
+        /**
+         * This method returns a range over every segment of the path.
+         */
+        PathSegments GetSegments() const;
+
+        /**
+         * This method returns a copy of every segment of the path.
+         */
+        std::vector<std::string> ToVector() const;
+
+        /**
+         * This is the equality comparison operator for the class.
+         *
+         * @param[in] other
+         *      This is the other path to which to compare this path.
+         * @return
+         *      An indication of whether or not the two paths have
+         *      the same segments is returned.
+         */
+        bool operator==(const PathStorage& other) const;
+
+        /**
+         * This method renders the path into the given output,
+         * encoding each segment as needed.
+         *
+         * @param[in, out] output
+         *      This is where to render the path.
+         */
+        template <typename Output> void Generate(Output& output) const {
+            if (!separatorInSegment_)
+            {
+                // The "/" characters in the buffer are all
+                // separators, so the whole path goes in one run.
+                output.AppendEncoded(buffer_, PATH_CHAR_NOT_PCT_ENCODED);
+                return;
+            }
+            size_t i = 0;
+            for (const auto segment : GetSegments())
+            {
+                if (i++ > 0)
+                { output.Append('/'); }
+                output.AppendEncoded(segment, PCHAR_NOT_PCT_ENCODED);
+            }
+        }
+
+    private:
+        /**
+         * This method works out the offset of the end of each
+         * segment from the buffer, whose "/" characters must all
+         * be separators.
+         */
+        void FindSegmentEnds();
+
+        // Properties
+    private:
+        /**
+         * This holds every segment, separated by "/" characters.
+         */
+        std::pmr::string buffer_;
+
+        /**
+         * This is the number of segments.  It can't be told from the
+         * buffer alone, since an empty buffer may hold no segment or
+         * one empty segment.
+         */
+        size_t segmentCount_ = 0;
+
+        /**
+         * This is the offset in the buffer just past the end of each
+         * segment.
+         */
+        std::pmr::vector<uint32_t> segmentEnds_;
+
+        /**
+         * This is an indication of whether or not any segment may
+         * hold a "/", so that the buffer can't be split on its own.
+         */
+        bool separatorInSegment_ = false;
+    };
+}  // namespace Uri
+
+#endif /* URI_PATH_STORAGE_HPP */
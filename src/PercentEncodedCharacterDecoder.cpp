@@ -7,80 +7,88 @@
  */
 
 #include "PercentEncodedCharacterDecoder.hpp"
-
-#include <cwctype>
+#include "SpanScanner.hpp"
+#include <string.h>
 
 namespace
 {
     /**
-     * This is the character set containing the numerical characters
-     * from the ASCII set.
+     * This function returns the length of the run of characters at the
+     * start of the given text which are copied as they are.
+     *
+     * @param[in] data
+     *      This points to the text to scan.
+     * @param[in] length
+     *      This is the number of characters in the text.
+     * @param[in] options
+     *      These are the ways in which the element is treated.
+     * @return
+     *      The length of the run is returned.
      */
-    const auto DIGIT = Uri::CharacterSet('0', '9');
-
-    const auto HEX = Uri::CharacterSet{Uri::CharacterSet('A', 'F'), Uri::CharacterSet('a', 'f')};
+    size_t FindRun(const char* data, size_t length, const Uri::DecodingOptions& options) {
+        if (options.allowedCharacters != nullptr)
+        { return Uri::FindFirstNotInSet(*options.allowedCharacters, data, length); }
+        if (options.plusAsSpace)
+        {
+            const auto next = std::string_view(data, length).find_first_of("%+");
+            return (next == std::string_view::npos) ? length : next;
+        }
+        const auto percent = (const char*)memchr(data, '%', length);
+        return (percent == nullptr) ? length : (size_t)(percent - data);
+    }
 }  // namespace
 
 namespace Uri
 {
-    struct PercentEncodedCharacterDecoder::Impl
-    {
-        // Properties
-        /**
-         * This is the decoded character
-         *
-         */
-        char decodedCharacter;
-
-        /**
-         * This is the needed number of digits to shift in.
-         *
-         */
-        size_t digitsLeft = 2;
-
-        // Methods
-        /**
-         * This method shifts in the hex character as part of building
-         * the decoded character.
-         *
-         * @param[c]
-         *      The hex digit param to shift into the decoded one
-         * @return
-         *      return an indication of whether or not the hex digit character is
-         *      shifted.
-         */
-        bool ShiftInHexDigit(char c) {
-            decodedCharacter <<= 4;
-            if (DIGIT.Contains(c))
+    size_t PercentEncodedCharacterDecoder::Decode(std::string_view encoded, char* decoded,
+                                                  const DecodingOptions& options) {
+        const auto length = encoded.length();
+        const auto data = encoded.data();
+        size_t position = 0;
+        size_t written = 0;
+        while (position < length)
+        {
+            // Copy the run of characters up to the next one
+            // needing decoding in one go.
+            const auto run = FindRun(data + position, length - position, options);
+            if ((run > 0) && (decoded + written != data + position))
+            { memmove(decoded + written, data + position, run); }
+            written += run;
+            position += run;
+            if (position == length)
+            { break; }
+            const auto c = data[position];
+            if (c != '%')
+            {
+                if ((c != '+') || !options.plusAsSpace || (options.allowedCharacters != nullptr))
+                { return std::string_view::npos; }
+                decoded[written++] = ' ';
+                ++position;
+                continue;
+            }
+            PercentEncodedCharacterDecoder pDecoder;
+            if ((length - position < 3) || !pDecoder.NextEncodedCharacter(data[position + 1]) ||
+                !pDecoder.NextEncodedCharacter(data[position + 2]))
             {
-                decodedCharacter += (int)(c - '0');
-            } else if (HEX.Contains(c))
+                if (!options.keepMalformed)
+                { return std::string_view::npos; }
+                decoded[written++] = '%';
+                ++position;
+                continue;
+            }
+            const auto decodedCharacter = pDecoder.GetDecodedCharacter();
+            if ((options.decodedCharacters == nullptr) ||
+                options.decodedCharacters->Contains(decodedCharacter))
             {
-                c = (char)towupper(c);
-                decodedCharacter += (int)(c - 'A') + 10;
+                decoded[written++] = decodedCharacter;
             } else
-            { return false; }
-            return true;
+            {
+                decoded[written++] = '%';
+                decoded[written++] = HEX_DIGITS[(unsigned char)decodedCharacter >> 4];
+                decoded[written++] = HEX_DIGITS[(unsigned char)decodedCharacter & 0x0F];
+            }
+            position += 3;
         }
-    };
-
-    PercentEncodedCharacterDecoder::~PercentEncodedCharacterDecoder() = default;
-    PercentEncodedCharacterDecoder::PercentEncodedCharacterDecoder(
-        PercentEncodedCharacterDecoder&&) = default;
-    PercentEncodedCharacterDecoder& PercentEncodedCharacterDecoder::operator=(
-        PercentEncodedCharacterDecoder&&) = default;
-    PercentEncodedCharacterDecoder::PercentEncodedCharacterDecoder() : impl_(new Impl) {}
-
-    bool PercentEncodedCharacterDecoder::NextEncodedCharacter(char c) {
-        if (!impl_->ShiftInHexDigit(c))
-        { return false; }
-        --impl_->digitsLeft;
-        return true;
-    }
-
-    bool PercentEncodedCharacterDecoder::Done() const { return impl_->digitsLeft == 0; }
-
-    char PercentEncodedCharacterDecoder::GetDecodedCharacter() const {
-        return (char)impl_->decodedCharacter;
+        return written;
     }
 }  // namespace Uri
@@ -10,36 +10,90 @@
  */
 #include "CharacterSet.hpp"
 #include <stddef.h>
-#include <memory>
+#include <stdint.h>
+#include <string_view>
 
 namespace Uri
 {
+    /**
+     * This is the table giving the value of each hexadecimal digit,
+     * indexed by character, with -1 for characters which are not
+     * hexadecimal digits.
+     */
+    struct HexDigitValues
+    {
+        int8_t values[256] = {};
+
+        constexpr HexDigitValues() {
+            for (int c = 0; c < 256; ++c)
+            { values[c] = -1; }
+            for (int c = '0'; c <= '9'; ++c)
+            { values[c] = (int8_t)(c - '0'); }
+            for (int c = 'A'; c <= 'F'; ++c)
+            {
+                values[c] = (int8_t)(c - 'A' + 10);
+                values[c - 'A' + 'a'] = (int8_t)(c - 'A' + 10);
+            }
+        }
+    };
+
+    /**
+     * This is the table of hexadecimal digit values, built at compile time.
+     */
+    inline constexpr HexDigitValues HEX_DIGIT_VALUES{};
+
+    /**
+     * This is the table of upper case hexadecimal digits, indexed by
+     * value, which every percent-encoding is written with.
+     */
+    inline constexpr char HEX_DIGITS[] = "0123456789ABCDEF";
+
+    /**
+     * These are the ways in which PercentEncodedCharacterDecoder::Decode
+     * may treat an element besides decoding its percent-encodings.
+     */
+    struct DecodingOptions
+    {
+        /**
+         * If not null, this is the set of characters the element may
+         * hold outside percent-encodings.  Any other character makes
+         * the element malformed.
+         */
+        const CharacterSet* allowedCharacters = nullptr;
+
+        /**
+         * If not null, this is the set of characters which are decoded.
+         * Any other percent-encoded character is written back encoded,
+         * with upper case hexadecimal digits.
+         */
+        const CharacterSet* decodedCharacters = nullptr;
+
+        /**
+         * This indicates whether or not a "+" is decoded as a space.
+         * It is only used if there is no set of allowed characters.
+         */
+        bool plusAsSpace = false;
+
+        /**
+         * This indicates whether or not a malformed percent-encoding
+         * is copied as it is, rather than making the element malformed.
+         */
+        bool keepMalformed = false;
+    };
+
     /**
      * This class take in a percent-encoded character,
      * decode it, and detect encoding essue.
+     *
+     * It is a small value type, so a new one may be made for
+     * every percent-encoded character at no cost.
      */
     class PercentEncodedCharacterDecoder
     {
-        // Lifecycle management
-    public:
-        ~PercentEncodedCharacterDecoder();
-        PercentEncodedCharacterDecoder(const PercentEncodedCharacterDecoder&) =
-            delete;  // Copy Constructor that creates a new object by making a copy of an existing
-                     // object.
-        // It ensures that a deep copy is performed if the object contains dynamically allocated
-        // resources
-        PercentEncodedCharacterDecoder(
-            PercentEncodedCharacterDecoder&&);  // Move Constructor that transfers resources from an
-                                                // expiring object to a newly constructed object.
-        PercentEncodedCharacterDecoder& operator=(const PercentEncodedCharacterDecoder&) =
-            delete;  // Copy Assignment Operation That assigns the values of one object to another
-                     // object using the assignment operator (=)
-        PercentEncodedCharacterDecoder& operator=(
-            PercentEncodedCharacterDecoder&&);  // Move Assignment Operator: Amove assignment
-                                                // operator efficiently transfers resources from one
-                                                // object to another. Methods
+        // Methods
     public:
-        PercentEncodedCharacterDecoder();
+        constexpr PercentEncodedCharacterDecoder() = default;
+
         /**
          * This methode inputs the next encoded character.
          *
@@ -49,7 +103,15 @@ namespace Uri
          *      returns an indication of whether or not the encoded character
          *      was accepted.
          */
-        bool NextEncodedCharacter(char c);
+        constexpr bool NextEncodedCharacter(char c) {
+            const auto value = HEX_DIGIT_VALUES.values[(unsigned char)c];
+            if ((value < 0) || (digitsLeft_ == 0))
+            { return false; }
+            decodedCharacter_ = (uint8_t)((decodedCharacter_ << 4) | value);
+            --digitsLeft_;
+            return true;
+        }
+
         /**
          * This method checks if the decoder is done
          * and has decoded the encoded character.
@@ -58,30 +120,52 @@ namespace Uri
          *      returns an indication of whether or not the decoder is done
          *      and has decoded the encoded character.
          */
-        bool Done() const;
+        constexpr bool Done() const { return digitsLeft_ == 0; }
+
         /**
          * This method returns the decoded charachter, one is done.
          *
          * @return
          *      returns the decoded charecter.
          */
-        char GetDecodedCharacter() const;
-        //
+        constexpr char GetDecodedCharacter() const { return (char)decodedCharacter_; }
+
+        /**
+         * This function decodes every percent-encoded character of the
+         * given element in one pass, copying the other characters as they are.
+         *
+         * @param[in] encoded
+         *      This is the element to decode.
+         * @param[out] decoded
+         *      This is where to write the decoded element.  It must have
+         *      room for at least as many characters as the encoded element,
+         *      since decoding never makes an element longer.  It may be
+         *      where the encoded element is, to decode it in place.
+         * @param[in] options
+         *      These are the ways in which to treat the element.
+         * @return
+         *      The number of characters written is returned.
+         * @retval std::string_view::npos
+         *      This is returned if the element holds a malformed
+         *      percent-encoding, unless these are kept, or a character
+         *      which isn't allowed.
+         */
+        static size_t Decode(std::string_view encoded, char* decoded,
+                             const DecodingOptions& options = DecodingOptions());
 
         // Properties
     private:
         /**
-         * This is the type of structure that contains the private
-         * properties of the instance. It is defined in the implementation
-         * and declared here to ensure that iwt is scoped inside the class.
+         * This is the decoded character, built one hex digit at a time.
          */
-        struct Impl;
+        uint8_t decodedCharacter_ = 0;
+
         /**
-         * This contains the private properties of the instance.
+         * This is the needed number of digits to shift in.
          */
-        std::unique_ptr<struct Impl> impl_;
+        uint8_t digitsLeft_ = 2;
     };
 
 }  // namespace Uri
 
-#endif /*URI_PERCENT_ENCODED_CHARACTER_DECODER_HPP*/
\ No newline at end of file
+#endif /*URI_PERCENT_ENCODED_CHARACTER_DECODER_HPP*/
@@ -0,0 +1,535 @@
+/**
+ * @file PushParser.cpp
+ *
+ * This module contains the implementation of the Uri::PushParser class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "ParsedElements.hpp"
+#include "PercentEncodedCharacterDecoder.hpp"
+#include "SpanScanner.hpp"
+#include "UriComponents.hpp"
+#include <Uri/PushParser.hpp>
+#include <string>
+
+namespace
+{
+    /**
+     * These are the places in a URI string the parser may be at
+     * between two pieces.
+     */
+    enum class ParserState
+    {
+        /**
+         * The characters so far are either the scheme or
+         * the start of the path; which one is known at the
+         * first ":", "/", "?" or "#".
+         */
+        SchemeOrPath,
+
+        /**
+         * The scheme, if any, is done, and the authority may follow.
+         */
+        HierarchyStart,
+
+        /**
+         * One "/" was seen after the scheme, which starts the
+         * authority if another "/" follows, or else the path.
+         */
+        HierarchySlash,
+
+        /**
+         * The characters are those of the authority.
+         */
+        Authority,
+
+        /**
+         * The characters are those of the path.
+         */
+        Path,
+
+        /**
+         * The characters are those of the query.
+         */
+        Query,
+
+        /**
+         * The characters are those of the fragment.
+         */
+        Fragment,
+
+        /**
+         * The URI string is known not to be valid.
+         */
+        Failed,
+    };
+}  // namespace
+
+namespace Uri
+{
+    /**
+     * This contains the private properties of PushParser instance.
+     */
+    struct PushParser::Impl
+    {
+        /**
+         * This is where the parser is in the URI string.
+         */
+        ParserState state = ParserState::SchemeOrPath;
+
+        /**
+         * This holds the characters of the scheme, or of the authority,
+         * until their end is seen.
+         */
+        std::string pending;
+
+        /**
+         * This holds the decoded characters of the current path segment.
+         */
+        std::pmr::string segment;
+
+        /**
+         * This is the number of characters of the path seen so far.
+         */
+        size_t pathLength = 0;
+
+        /**
+         * This is an indication of whether or not the parser is in the
+         * middle of a percent-encoded character.
+         */
+        bool decodingPercent = false;
+
+        /**
+         * This decodes the percent-encoded character in progress.
+         */
+        PercentEncodedCharacterDecoder decoder;
+
+        /**
+         * These are the elements of the URI decoded so far.
+         */
+        ParsedElements elements;
+
+        // Methods
+
+        /**
+         * This method empties the parser, keeping the storage
+         * allocated for the elements.
+         */
+        void Reset() {
+            state = ParserState::SchemeOrPath;
+            pending.clear();
+            segment.clear();
+            pathLength = 0;
+            decodingPercent = false;
+            elements.Clear();
+        }
+
+        /**
+         * This method takes the next character of a percent-encoding.
+         *
+         * @param[in] c
+         *      This is the next character of the percent-encoding.
+         * @param[in, out] output
+         *      This is where to add the decoded character, once complete.
+         */
+        void DecodePercent(char c, std::pmr::string& output) {
+            if (!decoder.NextEncodedCharacter(c))
+            {
+                state = ParserState::Failed;
+                return;
+            }
+            if (decoder.Done())
+            {
+                output.push_back(decoder.GetDecodedCharacter());
+                decodingPercent = false;
+            }
+        }
+
+        /**
+         * This method takes the characters of the given piece
+         * of the URI string, from the given position on.
+         *
+         * @param[in] chunk
+         *      This is the piece of the URI string.
+         */
+        void Consume(std::string_view chunk) {
+            size_t position = 0;
+            while (position < chunk.length())
+            {
+                switch (state)
+                {
+                case ParserState::SchemeOrPath: {
+                    const auto delimiter = chunk.find_first_of(":/?#", position);
+                    pending.append(chunk.substr(position, delimiter - position));
+                    if (delimiter == std::string_view::npos)
+                    {
+                        position = chunk.length();
+                    } else if (chunk[delimiter] == ':')
+                    {
+                        if (!ValidateScheme(pending))
+                        {
+                            state = ParserState::Failed;
+                            return;
+                        }
+                        elements.scheme.assign(pending);
+                        LowerCaseInPlace(elements.scheme);
+                        pending.clear();
+                        position = delimiter + 1;
+                        state = ParserState::HierarchyStart;
+                    } else
+                    {
+                        position = delimiter;
+                        EndSchemeOrPath();
+                    }
+                }
+                break;
+
+                case ParserState::HierarchyStart: {
+                    if (chunk[position] == '/')
+                    {
+                        ++position;
+                        state = ParserState::HierarchySlash;
+                    } else
+                    { state = ParserState::Path; }
+                }
+                break;
+
+                case ParserState::HierarchySlash: {
+                    if (chunk[position] == '/')
+                    {
+                        ++position;
+                        state = ParserState::Authority;
+                    } else
+                    {
+                        state = ParserState::Path;
+                        (void)ConsumePath("/", 0);
+                    }
+                }
+                break;
+
+                case ParserState::Authority: {
+                    const auto authorityEnd = chunk.find_first_of("/?#", position);
+                    pending.append(chunk.substr(position, authorityEnd - position));
+                    if (authorityEnd == std::string_view::npos)
+                    {
+                        position = chunk.length();
+                    } else
+                    {
+                        position = authorityEnd;
+                        EndAuthority();
+                    }
+                }
+                break;
+
+                case ParserState::Path: {
+                    position = ConsumePath(chunk, position);
+                }
+                break;
+
+                case ParserState::Query: {
+                    // The query is also kept as it appears, without
+                    // the "#" which may end it.
+                    const auto start = position;
+                    position = ConsumeQueryOrFragment(chunk, position, elements.query);
+                    const auto end = (state == ParserState::Fragment) ? (position - 1) : position;
+                    elements.rawQuery.append(chunk.substr(start, end - start));
+                }
+                break;
+
+                case ParserState::Fragment: {
+                    position = ConsumeQueryOrFragment(chunk, position, elements.fragment);
+                }
+                break;
+
+                case ParserState::Failed: {
+                    return;
+                }
+                }
+            }
+        }
+
+        /**
+         * This method is called once it is known that the characters
+         * held as a possible scheme are the start of the path instead.
+         */
+        void EndSchemeOrPath() {
+            if (pending.empty())
+            {
+                state = ParserState::HierarchyStart;
+                return;
+            }
+            // The characters held include no delimiter,
+            // so the path takes every one of them.
+            state = ParserState::Path;
+            (void)ConsumePath(pending, 0);
+            pending.clear();
+        }
+
+        /**
+         * This method parses the authority held, once its end is seen.
+         */
+        void EndAuthority() {
+            state = ParserState::Path;
+            ComponentLayout layout;
+            if (!LocateAuthority(pending, 0, pending.length(), layout))
+            {
+                state = ParserState::Failed;
+                return;
+            }
+
+            // user info parse
+            if (layout.hasUserInfo)
+            {
+                const auto userInfo = Slice(pending, layout.userInfo);
+                const auto userInfoDelimiter = userInfo.find(':');
+                if (!DecodeElement(userInfo.substr(0, userInfoDelimiter), USER_INFO_CHAR,
+                                   elements.userName) ||
+                    ((userInfoDelimiter != std::string_view::npos) &&
+                     !DecodeElement(userInfo.substr(userInfoDelimiter + 1), USER_INFO_CHAR,
+                                    elements.userPass)))
+                {
+                    state = ParserState::Failed;
+                    return;
+                }
+            }
+
+            // host parse
+            const auto host = Slice(pending, layout.host);
+            if (!layout.hostIsIpLiteral)
+            {  // reg-name or IPv4Address
+                if (!DecodeElement(host, REG_NAME_NOT_PCT_ENCODED, elements.host))
+                {
+                    state = ParserState::Failed;
+                    return;
+                }
+                LowerCaseInPlace(elements.host);
+                elements.hostKind = HostKind::RegName;
+                elements.hostAddress = HostAddress();
+                if (ParseIPv4Address(elements.host, elements.hostAddress.ipv4))
+                {
+                    elements.hostKind = HostKind::IPv4;
+                    elements.hostAddress.family = AddressFamily::IPv4;
+                }
+            } else
+            {  // IPv6Address or IPvFuture
+                if (!ParseIpLiteral(host, elements.hostAddress))
+                {
+                    state = ParserState::Failed;
+                    return;
+                }
+                elements.hostKind = (elements.hostAddress.family == AddressFamily::IPv6)
+                                        ? HostKind::IPv6
+                                        : HostKind::IPvFuture;
+                elements.host.assign(host);
+            }
+
+            // port parse
+            const auto port = Slice(pending, layout.port);
+            if (!port.empty())
+            {
+                if (!ParseUint16(port, elements.port))
+                {
+                    state = ParserState::Failed;
+                    return;
+                }
+                elements.hasPort = true;
+            }
+            pending.clear();
+        }
+
+        /**
+         * This method takes characters of the path, up to the end
+         * of the given piece or of the path, whichever comes first.
+         *
+         * @param[in] chunk
+         *      This is the piece of the URI string.
+         * @param[in] position
+         *      This is where the characters of the path start in the piece.
+         * @return
+         *      The position of the first character not taken is returned.
+         */
+        size_t ConsumePath(std::string_view chunk, size_t position) {
+            while (position < chunk.length())
+            {
+                if (decodingPercent)
+                {
+                    DecodePercent(chunk[position++], segment);
+                    ++pathLength;
+                    if (state == ParserState::Failed)
+                    { return chunk.length(); }
+                    continue;
+                }
+
+                // Take the run of characters which need no decoding in one go.
+                const auto run = FindFirstNotInSet(PCHAR_NOT_PCT_ENCODED, chunk.data() + position,
+                                                   chunk.length() - position);
+                segment.append(chunk.data() + position, run);
+                pathLength += run;
+                position += run;
+                if (position == chunk.length())
+                { break; }
+                const auto c = chunk[position++];
+                if (c == '/')
+                {
+                    ++pathLength;
+                    elements.path.AppendSegment(segment);
+                    segment.clear();
+                } else if (c == '%')
+                {
+                    ++pathLength;
+                    decodingPercent = true;
+                    decoder = PercentEncodedCharacterDecoder();
+                } else if ((c == '?') || (c == '#'))
+                {
+                    EndPath();
+                    if (state == ParserState::Failed)
+                    { return chunk.length(); }
+                    if (c == '?')
+                    {
+                        elements.hasQuery = true;
+                        state = ParserState::Query;
+                    } else
+                    {
+                        elements.hasFragment = true;
+                        state = ParserState::Fragment;
+                    }
+                    return position;
+                } else
+                {
+                    state = ParserState::Failed;
+                    return chunk.length();
+                }
+            }
+            return position;
+        }
+
+        /**
+         * This method is called once the end of the path is seen.
+         */
+        void EndPath() {
+            if (decodingPercent || (pathLength > UINT32_MAX))
+            {
+                state = ParserState::Failed;
+                return;
+            }
+
+            // A path of just "/" is a single empty segment.  Any other
+            // path not empty has one more segment than it has "/".
+            if ((pathLength > 0) && !((pathLength == 1) && (elements.path.GetSegmentCount() == 1)))
+            { elements.path.AppendSegment(segment); }
+            segment.clear();
+
+            // Handle special case of absolute URI with empty
+            // path -- treat the same as "/" path.
+            if (!elements.host.empty() && elements.path.IsEmpty())
+            { elements.path.AppendSegment(""); }
+        }
+
+        /**
+         * This method takes characters of the query or fragment, up to
+         * the end of the given piece or of the element, whichever comes first.
+         *
+         * @param[in] chunk
+         *      This is the piece of the URI string.
+         * @param[in] position
+         *      This is where the characters of the element start in the piece.
+         * @param[in, out] output
+         *      This is where to add the decoded characters.
+         * @return
+         *      The position of the first character not taken is returned.
+         */
+        size_t ConsumeQueryOrFragment(std::string_view chunk, size_t position,
+                                      std::pmr::string& output) {
+            while (position < chunk.length())
+            {
+                if (decodingPercent)
+                {
+                    DecodePercent(chunk[position++], output);
+                    if (state == ParserState::Failed)
+                    { return chunk.length(); }
+                    continue;
+                }
+
+                // Take the run of characters which need no decoding in one go.
+                const auto run = FindFirstNotInSet(QUERY_OR_FRAGMENT_CHAR, chunk.data() + position,
+                                                   chunk.length() - position);
+                output.append(chunk.data() + position, run);
+                position += run;
+                if (position == chunk.length())
+                { break; }
+                const auto c = chunk[position++];
+                if (c == '%')
+                {
+                    decodingPercent = true;
+                    decoder = PercentEncodedCharacterDecoder();
+                } else if ((c == '#') && (state == ParserState::Query))
+                {
+                    elements.hasFragment = true;
+                    state = ParserState::Fragment;
+                    return position;
+                } else
+                {
+                    state = ParserState::Failed;
+                    return chunk.length();
+                }
+            }
+            return position;
+        }
+
+        /**
+         * This method completes the parse once the end of the
+         * URI string is seen.
+         *
+         * @return
+         *      An indication of whether or not the URI string
+         *      was parsed successfully is returned.
+         */
+        bool End() {
+            if (state == ParserState::SchemeOrPath)
+            { EndSchemeOrPath(); }
+            if (state == ParserState::HierarchyStart)
+            { state = ParserState::Path; }
+            if (state == ParserState::HierarchySlash)
+            {
+                state = ParserState::Path;
+                (void)ConsumePath("/", 0);
+            }
+            if (state == ParserState::Authority)
+            { EndAuthority(); }
+            if (state == ParserState::Path)
+            {
+                EndPath();
+            } else if (decodingPercent)
+            { state = ParserState::Failed; }
+            return (state != ParserState::Failed);
+        }
+    };
+
+    PushParser::~PushParser() = default;
+    PushParser::PushParser(PushParser&&) noexcept = default;
+    PushParser& PushParser::operator=(PushParser&&) noexcept = default;
+
+    PushParser::PushParser() : impl_(new Impl) {}
+
+    void PushParser::Reset() { impl_->Reset(); }
+
+    bool PushParser::Feed(std::string_view chunk) {
+        impl_->Consume(chunk);
+        return (impl_->state != ParserState::Failed);
+    }
+
+    bool PushParser::Feed(const std::string_view* chunks, size_t count) {
+        for (size_t i = 0; i < count; ++i)
+        { impl_->Consume(chunks[i]); }
+        return (impl_->state != ParserState::Failed);
+    }
+
+    bool PushParser::Finish(Uri& uri) {
+        const auto parsed = impl_->End();
+        if (parsed)
+        { uri.TakeElements(impl_->elements); }
+        impl_->Reset();
+        return parsed;
+    }
+}  // namespace Uri
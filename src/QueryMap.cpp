@@ -0,0 +1,226 @@
+/**
+ * @file QueryMap.cpp
+ *
+ * This module contains the implementation of the Uri::QueryMap class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "PercentEncodedCharacterDecoder.hpp"
+#include "SpanScanner.hpp"
+#include "UriComponents.hpp"
+#include <Uri/QueryMap.hpp>
+#include <algorithm>
+#include <string.h>
+
+namespace
+{
+    /**
+     * This function returns the length of the given key or value
+     * once percent-encoded in the canonical form.
+     */
+    size_t EncodedLength(std::string_view element) {
+        size_t length = 0;
+        size_t position = 0;
+        for (;;)
+        {
+            const auto run = Uri::FindFirstNotInSet(Uri::UNRESERVED, element.data() + position,
+                                                    element.length() - position);
+            length += run;
+            position += run;
+            if (position == element.length())
+            { break; }
+            length += 3;
+            ++position;
+        }
+        return length;
+    }
+
+    /**
+     * This function appends the given key or value to the given buffer,
+     * percent-encoding everything but unreserved characters.
+     */
+    void AppendEncoded(std::string_view element, std::string& buffer) {
+        size_t position = 0;
+        for (;;)
+        {
+            const auto run = Uri::FindFirstNotInSet(Uri::UNRESERVED, element.data() + position,
+                                                    element.length() - position);
+            buffer.append(element.data() + position, run);
+            position += run;
+            if (position == element.length())
+            { break; }
+            const auto c = (unsigned char)element[position++];
+            buffer.push_back('%');
+            buffer.push_back(Uri::HEX_DIGITS[c >> 4]);
+            buffer.push_back(Uri::HEX_DIGITS[c & 0x0F]);
+        }
+    }
+}  // namespace
+
+namespace Uri
+{
+    QueryMap::QueryMap(const QueryParameters& parameters) {
+        // Decoding never makes a key or value longer, so the raw query
+        // bounds the text, and its "&" characters bound the parameters.
+        const auto rawQuery = parameters.GetRawQuery();
+        text_.resize(rawQuery.length());
+        slots_.reserve((size_t)std::count(rawQuery.begin(), rawQuery.end(), '&') + 1);
+        size_t written = 0;
+        for (const auto& parameter : parameters)
+        {
+            Slot slot;
+            slot.keyOffset = written;
+            slot.keyLength = DecodeQueryComponentTo(parameter.key, &text_[written], true);
+            written += slot.keyLength;
+            slot.valueOffset = written;
+            slot.valueLength = DecodeQueryComponentTo(parameter.value, &text_[written], true);
+            written += slot.valueLength;
+            slots_.push_back(slot);
+        }
+        text_.resize(written);
+        textInUse_ = written;
+        const std::string_view text(text_);
+        std::stable_sort(slots_.begin(), slots_.end(), [text](const Slot& lhs, const Slot& rhs) {
+            return (text.substr(lhs.keyOffset, lhs.keyLength) <
+                    text.substr(rhs.keyOffset, rhs.keyLength));
+        });
+    }
+
+    bool QueryMap::Has(std::string_view key) const {
+        const auto range = FindSlots(key);
+        return (range.first != range.second);
+    }
+
+    std::string_view QueryMap::Get(std::string_view key) const {
+        const auto range = FindSlots(key);
+        if (range.first == range.second)
+        { return std::string_view(); }
+        const auto& slot = slots_[range.first];
+        return std::string_view(text_).substr(slot.valueOffset, slot.valueLength);
+    }
+
+    QueryMap::Range QueryMap::GetAll(std::string_view key) const {
+        const auto range = FindSlots(key);
+        return Range{const_iterator(text_.data(), slots_.data() + range.first),
+                     const_iterator(text_.data(), slots_.data() + range.second)};
+    }
+
+    void QueryMap::Set(std::string_view key, std::string_view value) {
+        // The key or value may be a view of the text of the map,
+        // which is about to change, so they are copied first.
+        std::string copy;
+        const auto text = std::string_view(text_);
+        const auto isInText = [text](std::string_view view) {
+            return (!view.empty() && (view.data() >= text.data()) &&
+                    (view.data() < text.data() + text.length()));
+        };
+        if (isInText(key) || isInText(value))
+        {
+            copy.append(key).append(value);
+            key = std::string_view(copy).substr(0, key.length());
+            value = std::string_view(copy).substr(key.length());
+        }
+
+        const auto range = FindSlots(key);
+        if (range.first == range.second)
+        {
+            MakeRoom(key.length() + value.length());
+            Slot slot;
+            slot.keyOffset = text_.length();
+            slot.keyLength = key.length();
+            slot.valueOffset = slot.keyOffset + key.length();
+            slot.valueLength = value.length();
+            text_.append(key).append(value);
+            textInUse_ += key.length() + value.length();
+            (void)slots_.insert(slots_.begin() + range.first, slot);
+            return;
+        }
+
+        for (size_t i = range.first + 1; i < range.second; ++i)
+        { textInUse_ -= slots_[i].keyLength + slots_[i].valueLength; }
+        (void)slots_.erase(slots_.begin() + range.first + 1, slots_.begin() + range.second);
+        auto& slot = slots_[range.first];
+        textInUse_ -= slot.valueLength;
+        if (value.length() <= slot.valueLength)
+        {
+            // The new value fits where the old one was.
+            if (!value.empty())
+            { memcpy(&text_[slot.valueOffset], value.data(), value.length()); }
+        } else
+        {
+            slot.valueLength = 0;
+            MakeRoom(value.length());
+            slot.valueOffset = text_.length();
+            text_.append(value);
+        }
+        slot.valueLength = value.length();
+        textInUse_ += value.length();
+    }
+
+    size_t QueryMap::Remove(std::string_view key) {
+        const auto range = FindSlots(key);
+        for (size_t i = range.first; i < range.second; ++i)
+        { textInUse_ -= slots_[i].keyLength + slots_[i].valueLength; }
+        (void)slots_.erase(slots_.begin() + range.first, slots_.begin() + range.second);
+        if (slots_.empty())
+        { text_.clear(); }
+        return (range.second - range.first);
+    }
+
+    std::string QueryMap::GenerateString() const {
+        std::string buffer;
+        AppendTo(buffer);
+        return buffer;
+    }
+
+    void QueryMap::AppendTo(std::string& buffer) const {
+        // Work out the length first, so that the buffer is grown once.
+        size_t length = 0;
+        for (const auto entry : *this)
+        { length += EncodedLength(entry.key) + 1 + EncodedLength(entry.value) + 1; }
+        if (length > 0)
+        { --length; }
+        buffer.reserve(buffer.length() + length);
+        bool first = true;
+        for (const auto entry : *this)
+        {
+            if (!first)
+            { buffer.push_back('&'); }
+            first = false;
+            AppendEncoded(entry.key, buffer);
+            buffer.push_back('=');
+            AppendEncoded(entry.value, buffer);
+        }
+    }
+
+    std::pair<size_t, size_t> QueryMap::FindSlots(std::string_view key) const {
+        const std::string_view text(text_);
+        const auto first = std::lower_bound(
+            slots_.begin(), slots_.end(), key, [text](const Slot& slot, std::string_view wanted) {
+                return (text.substr(slot.keyOffset, slot.keyLength) < wanted);
+            });
+        const auto last = std::upper_bound(
+            first, slots_.end(), key, [text](std::string_view wanted, const Slot& slot) {
+                return (wanted < text.substr(slot.keyOffset, slot.keyLength));
+            });
+        return std::make_pair((size_t)(first - slots_.begin()), (size_t)(last - slots_.begin()));
+    }
+
+    void QueryMap::MakeRoom(size_t length) {
+        if (text_.length() - textInUse_ <= textInUse_)
+        { return; }
+        std::string compacted;
+        compacted.reserve(textInUse_ + length);
+        for (auto& slot : slots_)
+        {
+            const auto keyOffset = compacted.length();
+            compacted.append(text_, slot.keyOffset, slot.keyLength);
+            const auto valueOffset = compacted.length();
+            compacted.append(text_, slot.valueOffset, slot.valueLength);
+            slot.keyOffset = keyOffset;
+            slot.valueOffset = valueOffset;
+        }
+        text_.swap(compacted);
+    }
+}  // namespace Uri
@@ -0,0 +1,34 @@
+/**
+ * @file QueryParameters.cpp
+ *
+ * This module contains the implementation of the functions
+ * declared along with the Uri::QueryParameters class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "PercentEncodedCharacterDecoder.hpp"
+#include "UriComponents.hpp"
+#include <Uri/QueryParameters.hpp>
+
+namespace Uri
+{
+    size_t DecodeQueryComponentTo(std::string_view encoded, char* decoded, bool plusAsSpace) {
+        DecodingOptions options;
+        options.plusAsSpace = plusAsSpace;
+        options.keepMalformed = true;
+        return PercentEncodedCharacterDecoder::Decode(encoded, decoded, options);
+    }
+
+    std::string_view DecodeQueryComponent(std::string_view encoded, std::string& scratch,
+                                          bool plusAsSpace) {
+        if (encoded.find_first_of(plusAsSpace ? "%+" : "%") == std::string_view::npos)
+        { return encoded; }
+
+        // Decoding never makes a key or value longer, so the scratch
+        // string is grown once and written through a pointer.
+        scratch.resize(encoded.length());
+        scratch.resize(DecodeQueryComponentTo(encoded, &scratch[0], plusAsSpace));
+        return scratch;
+    }
+}  // namespace Uri
@@ -0,0 +1,89 @@
+/**
+ * @file ResolutionBase.cpp
+ *
+ * This module contains the implementation of the Uri::ResolutionBase class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "PathStorage.hpp"
+#include <Uri/ResolutionBase.hpp>
+#include <algorithm>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Uri
+{
+    /**
+     * This contains the private properties of ResolutionBase instance.
+     */
+    struct ResolutionBase::Impl
+    {
+        /**
+         * This is the base URI, with every element decoded.
+         */
+        Uri base;
+
+        /**
+         * This is the path of the base without its last segment,
+         * onto which relative paths are merged, already split.
+         */
+        PathStorage mergePrefix;
+    };
+
+    ResolutionBase::~ResolutionBase() = default;
+    ResolutionBase::ResolutionBase(ResolutionBase&&) noexcept = default;
+    ResolutionBase& ResolutionBase::operator=(ResolutionBase&&) noexcept = default;
+
+    ResolutionBase::ResolutionBase(const Uri& base) : impl_(new Impl) {
+        impl_->base = base;
+
+        // Hashing decodes every element of the base, so that
+        // resolving never has to change it.
+        (void)impl_->base.GetHash();
+        const auto segments = impl_->base.GetPathSegments();
+        const auto prefixLength = (segments.size() > 1) ? (segments.size() - 1) : segments.size();
+        for (size_t i = 0; i < prefixLength; ++i)
+        { impl_->mergePrefix.AppendSegment(segments[i]); }
+    }
+
+    const Uri& ResolutionBase::GetBase() const { return impl_->base; }
+
+    void ResolutionBase::Resolve(const Uri& relativeReference, Uri& target) const {
+        if (&target == &relativeReference)
+        {
+            Uri resolved(target.GetMemoryResource());
+            impl_->base.ResolveInto(relativeReference, resolved, &impl_->mergePrefix);
+            target = std::move(resolved);
+            return;
+        }
+        impl_->base.ResolveInto(relativeReference, target, &impl_->mergePrefix);
+    }
+
+    Uri ResolutionBase::Resolve(const Uri& relativeReference) const {
+        Uri target;
+        impl_->base.ResolveInto(relativeReference, target, &impl_->mergePrefix);
+        return target;
+    }
+
+    void ResolutionBase::ResolveBatch(const Uri* relativeReferences, size_t count, Uri* targets,
+                                      size_t threadCount) const {
+        threadCount = std::max(std::min(threadCount, count), (size_t)1);
+        const auto resolveSlice = [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i)
+            { Resolve(relativeReferences[i], targets[i]); }
+        };
+
+        // Each thread resolves one contiguous slice, the calling
+        // thread taking the first.
+        const auto sliceSize = (count + threadCount - 1) / threadCount;
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount - 1);
+        for (size_t first = sliceSize; first < count; first += sliceSize)
+        { workers.emplace_back(resolveSlice, first, std::min(first + sliceSize, count)); }
+        resolveSlice(0, std::min(sliceSize, count));
+        for (auto& worker : workers)
+        { worker.join(); }
+    }
+}  // namespace Uri
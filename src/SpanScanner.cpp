@@ -0,0 +1,261 @@
+/**
+ * @file SpanScanner.cpp
+ *
+ * This module contains the implementation of the span scanner functions.
+ *
+ * Each vector implementation looks up every character of a block in
+ * the two nibble class tables of the character set with a byte shuffle,
+ * and the character is in the set when the two classes intersect.
+ * Sets holding non-ASCII characters cannot be represented that way
+ * and are always scanned one character at a time.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "SpanScanner.hpp"
+#include <stdint.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#    define URI_SPAN_SCANNER_X86
+#    define URI_TARGET(isa) __attribute__((target(isa)))
+#    include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#    define URI_SPAN_SCANNER_X86
+#    define URI_TARGET(isa)
+#    include <immintrin.h>
+#    include <intrin.h>
+#endif
+
+namespace
+{
+    /**
+     * This is the type of the functions implementing the span scanner.
+     */
+    using ScanFunction = size_t (*)(const Uri::CharacterSet&, const char*, size_t);
+
+    /**
+     * This function finds the first character in the given buffer
+     * which is not in the given character set, one character at a time.
+     *
+     * @param[in] characterSet
+     *      This is the set of characters to skip over.
+     * @param[in] data
+     *      This points to the first character to scan.
+     * @param[in] length
+     *      This is the number of characters to scan.
+     * @return
+     *      The offset of the first character not in the set is returned.
+     */
+    size_t FindFirstNotInSetScalar(const Uri::CharacterSet& characterSet, const char* data,
+                                   size_t length) {
+        size_t i = 0;
+        while ((i < length) && characterSet.Contains(data[i]))
+        { ++i; }
+        return i;
+    }
+
+#ifdef URI_SPAN_SCANNER_X86
+    /**
+     * This function returns the index of the lowest bit set
+     * in the given mask, which must not be zero.
+     *
+     * @param[in] mask
+     *      This is the mask to examine.
+     * @return
+     *      The index of the lowest bit set is returned.
+     */
+    size_t CountTrailingZeros(uint64_t mask) {
+#    if defined(_MSC_VER) && !defined(__clang__)
+#        if defined(_M_X64)
+        unsigned long index;
+        (void)_BitScanForward64(&index, mask);
+        return (size_t)index;
+#        else
+        unsigned long index;
+        if (_BitScanForward(&index, (unsigned long)mask))
+        { return (size_t)index; }
+        (void)_BitScanForward(&index, (unsigned long)(mask >> 32));
+        return (size_t)index + 32;
+#        endif
+#    else
+        return (size_t)__builtin_ctzll(mask);
+#    endif
+    }
+
+    URI_TARGET("ssse3")
+    size_t FindFirstNotInSetSsse3(const Uri::CharacterSet& characterSet, const char* data,
+                                  size_t length) {
+        const auto lowClasses =
+            _mm_loadu_si128((const __m128i*)characterSet.GetLowNibbleClasses());
+        const auto highClasses =
+            _mm_loadu_si128((const __m128i*)characterSet.GetHighNibbleClasses());
+        const auto nibbleMask = _mm_set1_epi8(0x0F);
+        const auto zero = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 16 <= length; i += 16)
+        {
+            const auto block = _mm_loadu_si128((const __m128i*)(data + i));
+            const auto low = _mm_shuffle_epi8(lowClasses, _mm_and_si128(block, nibbleMask));
+            const auto high = _mm_shuffle_epi8(
+                highClasses, _mm_and_si128(_mm_srli_epi16(block, 4), nibbleMask));
+            const auto outside = _mm_cmpeq_epi8(_mm_and_si128(low, high), zero);
+            const auto mask = (uint32_t)_mm_movemask_epi8(outside);
+            if (mask != 0)
+            { return i + CountTrailingZeros(mask); }
+        }
+        return i + FindFirstNotInSetScalar(characterSet, data + i, length - i);
+    }
+
+    URI_TARGET("avx2")
+    size_t FindFirstNotInSetAvx2(const Uri::CharacterSet& characterSet, const char* data,
+                                 size_t length) {
+        const auto lowClasses = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128((const __m128i*)characterSet.GetLowNibbleClasses()));
+        const auto highClasses = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128((const __m128i*)characterSet.GetHighNibbleClasses()));
+        const auto nibbleMask = _mm256_set1_epi8(0x0F);
+        const auto zero = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 32 <= length; i += 32)
+        {
+            const auto block = _mm256_loadu_si256((const __m256i*)(data + i));
+            const auto low =
+                _mm256_shuffle_epi8(lowClasses, _mm256_and_si256(block, nibbleMask));
+            const auto high = _mm256_shuffle_epi8(
+                highClasses, _mm256_and_si256(_mm256_srli_epi16(block, 4), nibbleMask));
+            const auto outside = _mm256_cmpeq_epi8(_mm256_and_si256(low, high), zero);
+            const auto mask = (uint32_t)_mm256_movemask_epi8(outside);
+            if (mask != 0)
+            { return i + CountTrailingZeros(mask); }
+        }
+        return i + FindFirstNotInSetScalar(characterSet, data + i, length - i);
+    }
+
+    URI_TARGET("avx512f,avx512bw")
+    size_t FindFirstNotInSetAvx512(const Uri::CharacterSet& characterSet, const char* data,
+                                   size_t length) {
+        const auto lowClasses = _mm512_broadcast_i32x4(
+            _mm_loadu_si128((const __m128i*)characterSet.GetLowNibbleClasses()));
+        const auto highClasses = _mm512_broadcast_i32x4(
+            _mm_loadu_si128((const __m128i*)characterSet.GetHighNibbleClasses()));
+        const auto nibbleMask = _mm512_set1_epi8(0x0F);
+        for (size_t i = 0; i < length; i += 64)
+        {
+            // The last block is loaded with a mask, so it never reads
+            // past the end of the buffer.
+            const auto remaining = length - i;
+            const __mmask64 inBuffer = (remaining >= 64) ? ~(__mmask64)0
+                                                         : (((__mmask64)1 << remaining) - 1);
+            const auto block = _mm512_maskz_loadu_epi8(inBuffer, data + i);
+            const auto low =
+                _mm512_shuffle_epi8(lowClasses, _mm512_and_si512(block, nibbleMask));
+            const auto high = _mm512_shuffle_epi8(
+                highClasses, _mm512_and_si512(_mm512_srli_epi16(block, 4), nibbleMask));
+            const auto outside = (uint64_t)(~_mm512_test_epi8_mask(low, high) & inBuffer);
+            if (outside != 0)
+            { return i + CountTrailingZeros(outside); }
+        }
+        return length;
+    }
+
+    /**
+     * This function asks the processor which vector extensions
+     * it (and the operating system) supports.
+     *
+     * @return
+     *      The widest supported scan level is returned.
+     */
+    Uri::ScanLevel DetectScanLevel() {
+#    if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        const auto maxLeaf = info[0];
+        __cpuid(info, 1);
+        const bool ssse3 = ((info[2] & (1 << 9)) != 0);
+        const bool osUsesXsave = ((info[2] & (1 << 27)) != 0);
+        bool avx2 = false;
+        bool avx512 = false;
+        if (osUsesXsave && (maxLeaf >= 7))
+        {
+            const auto xcr0 = _xgetbv(0);
+            __cpuidex(info, 7, 0);
+            avx2 = ((xcr0 & 0x06) == 0x06) && ((info[1] & (1 << 5)) != 0);
+            avx512 = ((xcr0 & 0xE6) == 0xE6) && ((info[1] & (1 << 16)) != 0) &&
+                     ((info[1] & (1 << 30)) != 0);
+        }
+#    else
+        __builtin_cpu_init();
+        const bool ssse3 = __builtin_cpu_supports("ssse3");
+        const bool avx2 = __builtin_cpu_supports("avx2");
+        const bool avx512 =
+            __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#    endif
+        if (avx512)
+        {
+            return Uri::ScanLevel::Avx512;
+        } else if (avx2)
+        {
+            return Uri::ScanLevel::Avx2;
+        } else if (ssse3)
+        {
+            return Uri::ScanLevel::Ssse3;
+        } else
+        { return Uri::ScanLevel::Scalar; }
+    }
+#else
+    Uri::ScanLevel DetectScanLevel() { return Uri::ScanLevel::Scalar; }
+#endif
+
+    /**
+     * This function returns the implementation of the span
+     * scanner for the given level.
+     *
+     * @param[in] level
+     *      This is the scan level whose implementation to return.
+     * @return
+     *      The implementation of the span scanner is returned.
+     */
+    ScanFunction GetScanFunction(Uri::ScanLevel level) {
+        switch (level)
+        {
+#ifdef URI_SPAN_SCANNER_X86
+        case Uri::ScanLevel::Avx512:
+            return FindFirstNotInSetAvx512;
+        case Uri::ScanLevel::Avx2:
+            return FindFirstNotInSetAvx2;
+        case Uri::ScanLevel::Ssse3:
+            return FindFirstNotInSetSsse3;
+#endif
+        default:
+            return FindFirstNotInSetScalar;
+        }
+    }
+
+    /**
+     * This is the shortest buffer for which handing off to a vector
+     * implementation pays for the indirect call.
+     */
+    constexpr size_t MINIMUM_VECTOR_SCAN_LENGTH = 16;
+}  // namespace
+
+namespace Uri
+{
+    ScanLevel GetSupportedScanLevel() {
+        static const ScanLevel supportedLevel = DetectScanLevel();
+        return supportedLevel;
+    }
+
+    size_t FindFirstNotInSet(const CharacterSet& characterSet, const char* data, size_t length) {
+        static const ScanFunction selectedFunction = GetScanFunction(GetSupportedScanLevel());
+        if ((length < MINIMUM_VECTOR_SCAN_LENGTH) || !characterSet.IsAscii())
+        { return FindFirstNotInSetScalar(characterSet, data, length); }
+        return selectedFunction(characterSet, data, length);
+    }
+
+    size_t FindFirstNotInSet(const CharacterSet& characterSet, const char* data, size_t length,
+                             ScanLevel level) {
+        if (!characterSet.IsAscii())
+        { level = ScanLevel::Scalar; }
+        return GetScanFunction(level)(characterSet, data, length);
+    }
+}  // namespace Uri
@@ -0,0 +1,97 @@
+#ifndef URI_SPAN_SCANNER_HPP
+#define URI_SPAN_SCANNER_HPP
+
+/**
+ * @file SpanScanner.hpp
+ *
+ * This module declares the functions which find the length of the
+ * leading run of characters belonging to a Uri::CharacterSet,
+ * using the widest vector instructions the processor supports.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "CharacterSet.hpp"
+#include <stddef.h>
+
+namespace Uri
+{
+    /**
+     * These are the implementations of the span scanner,
+     * from the narrowest to the widest.
+     */
+    enum class ScanLevel
+    {
+        /**
+         * One character at a time, on any processor.
+         */
+        Scalar,
+
+        /**
+         * 16 characters at a time, using SSSE3 byte shuffles.
+         */
+        Ssse3,
+
+        /**
+         * 32 characters at a time, using AVX2.
+         */
+        Avx2,
+
+        /**
+         * 64 characters at a time, using AVX-512BW.
+         */
+        Avx512,
+    };
+
+    /**
+     * This function returns the widest implementation of the span
+     * scanner which the processor running the program supports.
+     * The processor is only queried the first time.
+     *
+     * @return
+     *      The widest supported scan level is returned.
+     */
+    ScanLevel GetSupportedScanLevel();
+
+    /**
+     * This function finds the first character in the given buffer
+     * which is not in the given character set, using the widest
+     * supported implementation.
+     *
+     * @param[in] characterSet
+     *      This is the set of characters to skip over.
+     * @param[in] data
+     *      This points to the first character to scan.
+     * @param[in] length
+     *      This is the number of characters to scan.
+     * @return
+     *      The offset of the first character not in the set is returned.
+     * @retval length
+     *      This is returned if every character is in the set.
+     */
+    size_t FindFirstNotInSet(const CharacterSet& characterSet, const char* data, size_t length);
+
+    /**
+     * This function finds the first character in the given buffer
+     * which is not in the given character set, using the given
+     * implementation.
+     *
+     * @param[in] characterSet
+     *      This is the set of characters to skip over.
+     * @param[in] data
+     *      This points to the first character to scan.
+     * @param[in] length
+     *      This is the number of characters to scan.
+     * @param[in] level
+     *      This is the implementation to use.  It must not be wider
+     *      than the one returned by GetSupportedScanLevel.
+     * @return
+     *      The offset of the first character not in the set is returned.
+     * @retval length
+     *      This is returned if every character is in the set.
+     */
+    size_t FindFirstNotInSet(const CharacterSet& characterSet, const char* data, size_t length,
+                             ScanLevel level);
+}  // namespace Uri
+
+#endif /* URI_SPAN_SCANNER_HPP */
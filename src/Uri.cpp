@@ -6,389 +6,345 @@
  * © 2024 by Hatem Nabli
  */
 
-#include "CharacterSet.hpp"
+#include "ParsedElements.hpp"
+#include "PathStorage.hpp"
 #include "PercentEncodedCharacterDecoder.hpp"
-#include <StringUtils/StringUtils.hpp>
+#include "SpanScanner.hpp"
+#include "UriComponents.hpp"
 #include <Uri/Uri.hpp>
+#include <atomic>
+#include <string.h>
+#include <string_view>
 
 namespace
 {
-    // Singleton
     /**
-     * This is the character set containing the alphabetic characters
-     * from the ASCII characters.
+     * This function renders the given port number in decimal.
+     *
+     * @param[in] port
+     *      This is the port number to render.
+     * @param[out] digits
+     *      This is where to write the digits.
+     * @return
+     *      A view of the digits written is returned.
      */
-    const auto ALPHA = Uri::CharacterSet{Uri::CharacterSet('a', 'z'), Uri::CharacterSet('A', 'Z')};
+    std::string_view FormatPort(uint16_t port, char (&digits)[5]) {
+        size_t first = sizeof(digits);
+        do
+        {
+            digits[--first] = (char)('0' + port % 10);
+            port /= 10;
+        } while (port != 0);
+        return std::string_view(digits + first, sizeof(digits) - first);
+    }
+
     /**
-     * This is the character set containing the numerical characters
-     * from the ASCII set.
+     * This holds the port number used by a scheme
+     * when the URI doesn't give one.
      */
-    const auto DIGIT = Uri::CharacterSet('0', '9');
-
-    const auto HEX = Uri::CharacterSet{Uri::CharacterSet('A', 'F'), Uri::CharacterSet('a', 'f')};
+    struct DefaultPort
+    {
+        std::string_view scheme;
+        uint16_t port;
+    };
 
     /**
-     * This is the character st corresponds to the "unreserved" syntax
-     * specified in RFC 3986
+     * These are the default ports of the schemes
+     * which Uri::Normalize knows of.
      */
-    const auto UNRESERVED = Uri::CharacterSet{ALPHA, DIGIT, '.', '-', '_', '~'};
+    constexpr DefaultPort DEFAULT_PORTS[] = {
+        {"ftp", 21}, {"http", 80}, {"https", 443}, {"ws", 80}, {"wss", 443},
+    };
 
     /**
-     * This is the character st corresponds to the "sub-delims" syntax
-     * specified in RFC 3986
+     * This function returns the default port of the given scheme.
+     *
+     * @param[in] scheme
+     *      This is the scheme, in lowercase.
+     * @return
+     *      The default port of the scheme is returned.
+     * @retval 0
+     *      This is returned if the scheme has no default port known.
      */
-    const auto SUB_DELIMS =
-        Uri::CharacterSet{'!', '$', '&', '\'', '(', ')', '*', '+', ',', ';', '='};
+    uint16_t GetDefaultPort(std::string_view scheme) {
+        for (const auto& defaultPort : DEFAULT_PORTS)
+        {
+            if (defaultPort.scheme == scheme)
+            { return defaultPort.port; }
+        }
+        return 0;
+    }
+
     /**
-     * This is the character st corresponds to the second part of the "scheme" syntax
-     * specified in RFC 3986
+     * This function applies the "remove_dot_segments" routine of
+     * section 5.2.4 of RFC 3986 to the encoded path at the end of the
+     * given string, in place.  The output never gets ahead of the input
+     * left to read, so both are kept in the same string.
+     *
+     * @param[in, out] buffer
+     *      This is the string ending with the path.
+     * @param[in] pathStart
+     *      This is the offset of the path in the string.
      */
-    const auto SCHEME_NOT_FIRST = Uri::CharacterSet{ALPHA, DIGIT, '+', '-', '.'};
+    void RemoveDotSegmentsInPlace(std::string& buffer, size_t pathStart) {
+        const auto end = buffer.length();
+        auto in = pathStart;
+        auto out = pathStart;
+        const auto popSegment = [&] {
+            const auto lastSlash = std::string_view(buffer).substr(0, out).rfind('/');
+            out = ((lastSlash == std::string_view::npos) || (lastSlash < pathStart)) ? pathStart
+                                                                                     : lastSlash;
+        };
+        while (in < end)
+        {
+            const auto input = std::string_view(buffer).substr(in, end - in);
+            if (input.substr(0, 3) == "../")
+            {
+                in += 3;
+            } else if (input.substr(0, 2) == "./")
+            {
+                in += 2;
+            } else if (input.substr(0, 3) == "/./")
+            {
+                in += 2;
+            } else if (input == "/.")
+            {
+                // Replace it with "/".
+                buffer[++in] = '/';
+            } else if (input.substr(0, 4) == "/../")
+            {
+                in += 3;
+                popSegment();
+            } else if (input == "/..")
+            {
+                in += 2;
+                buffer[in] = '/';
+                popSegment();
+            } else if ((input == ".") || (input == ".."))
+            {
+                in = end;
+            } else
+            {
+                // Move the first segment, with the "/" before it if any,
+                // from the input to the output.
+                const auto segmentEnd = input.find('/', 1);
+                const auto segmentLength =
+                    (segmentEnd == std::string_view::npos) ? input.length() : segmentEnd;
+                memmove(&buffer[out], &buffer[in], segmentLength);
+                out += segmentLength;
+                in += segmentLength;
+            }
+        }
+        buffer.resize(out);
+    }
+
     /**
-     * This is the character st corresponds to the "pchar" syntax
-     * specified in RFC 3986
+     * This function mixes the given value into the given hash.
+     *
+     * @param[in] hash
+     *      This is the hash so far.
+     * @param[in] value
+     *      This is the value to mix in.
+     * @return
+     *      The combined hash is returned.
      */
-    const auto PCHAR_NOT_PCT_ENCODED = Uri::CharacterSet{UNRESERVED, SUB_DELIMS, ':', '@'};
-
-    const auto QUERY_OR_FRAGMENT_CHAR = Uri::CharacterSet{PCHAR_NOT_PCT_ENCODED, '/', '?'};
+    size_t CombineHash(size_t hash, size_t value) {
+        return hash ^ (value + (size_t)0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2));
+    }
 
-    const auto USER_INFO_CHAR = Uri::CharacterSet{UNRESERVED, SUB_DELIMS, ':'};
     /**
-     * This is the character set corresponds to the "reg-name" syntax
-     * specified in RFC 3986 (https://tools.ietf.org/html/rfc3986),
-     * leaving out "pct-encoded".
+     * This class holds the hash of a URI once it has been computed,
+     * with zero standing for a hash not computed yet.  It is atomic
+     * so that threads sharing a URI may compute and store its hash
+     * at the same time.
      */
-    const auto REG_NAME_NOT_PCT_ENCODED = Uri::CharacterSet{UNRESERVED, SUB_DELIMS};
+    class CachedHash
+    {
+    public:
+        CachedHash() = default;
+
+        CachedHash(const CachedHash& other) : value_(other.Get()) {}
+
+        CachedHash& operator=(const CachedHash& other) {
+            Set(other.Get());
+            return *this;
+        }
+
+        size_t Get() const { return value_.load(std::memory_order_relaxed); }
 
-    const auto IPV_LAST_PART_FUTURE = Uri::CharacterSet{UNRESERVED, SUB_DELIMS, ':'};
+        void Set(size_t value) const { value_.store(value, std::memory_order_relaxed); }
 
-    const auto HEXDIGIT = Uri::CharacterSet{
-        Uri::CharacterSet('0', '9'), Uri::CharacterSet('A', 'F'), Uri::CharacterSet('a', 'f')};
+        void Reset() { Set(0); }
+
+    private:
+        mutable std::atomic<size_t> value_{0};
+    };
 
     /**
-     * This fuction parses the given string as an unsigned 16-bit
-     * integer, detecting invalid characters, overflow, etc..
-     *
-     * @param[in] numberString
-     *      This is the string containing the number to parse.
-     *
-     * @param[out] number
-     *      This is where to store the number parsed.
+     * This function parses the given URI string into a URI kept
+     * for the calling thread, so that it can be compared and hashed
+     * without allocating once the storage of that URI has grown.
      *
+     * @param[in] uriString
+     *      This is the string rendering of the URI to parse.
      * @return
-     *      An indication of whether or not the number was parsed
-     *      successfully is returned.
+     *      The URI parsed is returned.
+     * @retval nullptr
+     *      This is returned if the URI string could not be parsed.
      */
-    bool ParseUint16(const std::string& numberString, uint16_t& number) {
-        uint32_t number32Bits = 0;
-        for (auto c : numberString)
-        {
-            if ((c < '0') || (c > '9'))
-            { return false; }
-            number32Bits *= 10;
-            number32Bits += (uint16_t)(c - '0');
-            if ((number32Bits & ~((1 << 16) - 1)) != 0)
-            { return false; }
-        }
-        number = (uint16_t)number32Bits;
-        return true;
+    const Uri::Uri* ParseScratchUri(std::string_view uriString) {
+        thread_local Uri::Uri scratch;
+        if (!scratch.ParseFromString(uriString))
+        { return nullptr; }
+        return &scratch;
     }
 
     /**
-     * This function takes a given "stillPassing" strategy
-     * and invokes it on the sequence of characters in the given
-     * string, to check if the string passes or not.
+     * This function gives the contents of one string to another,
+     * swapping their storage when they share a memory resource,
+     * so that neither has to allocate.
      *
-     * @param[in] candidate
-     *      This is the string to test.
-     * @param[in] stillOkStrategy
-     *      This is the strategy to invoke in the order to test the string.
-     * @return
-     *      An indication of whether or not the given candidate string
-     *      passes the test strategy is returned.
+     * @param[in, out] target
+     *      This is the string to give the contents to.
+     * @param[in, out] source
+     *      This is the string whose contents to give.
+     *      It is left with unspecified contents.
      */
-    bool FailsMatch(const std::string& candidate, std::function<bool(char, bool)> stillOkStrategy) {
-        for (const auto c : candidate)
+    void TakeString(std::pmr::string& target, std::pmr::string& source) {
+        if (target.get_allocator() == source.get_allocator())
         {
-            if (!stillOkStrategy(c, false))
-            { return true; }
-        }
-        return !stillOkStrategy(' ', true);
+            target.swap(source);
+        } else
+        { target.assign(source); }
     }
+
     /**
-     * This function checks to make sur that the given string
-     * is a valid rendering of an octet as a decimal number.
-     *
-     * @param[in] octetString
-     *      This is the octet string to validate.
-     *
-     * @return
-     *      An indication of whether or not the given string
-     *      is a valid rendation ofa na octet as a decimal
-     *      number is returned
+     * These are the elements of a URI which a lazy parse keeps
+     * encoded.  They index the encoded forms a URI holds.
      */
-    bool ValidateOctet(const std::string& octetString) {
-        int octet = 0;
-        for (auto c : octetString)
-        {
-            if (DIGIT.Contains(c))
-            {
-                octet *= 10;
-                octet += (int)(c - '0');
-            } else
-            { return false; }
-        }
-        return (octet <= 255);
-    }
+    enum EncodedElement : size_t
+    {
+        USER_INFO_ELEMENT,
+        PATH_ELEMENT,
+        QUERY_ELEMENT,
+        FRAGMENT_ELEMENT,
+        ENCODED_ELEMENT_COUNT
+    };
+
     /**
-     * This function checks to make sure that the address
-     * is a valid IPv4 address according to RFC 3986
+     * This function returns the bit standing for the given element
+     * in a set of encoded elements.
      *
-     * @param[in] address
-     *      This is an IPv4Address to validate
+     * @param[in] element
+     *      This is the element whose bit to return.
      * @return
-     *      return an indication of whether or not the address
-     *      is a valid IPv4 address.
+     *      The bit standing for the element is returned.
      */
-    bool ValidateIPv4Address(const std::string& address) {
-        size_t numGroups = 0;
-        size_t state = 0;
-        std::string octetBuffer;
-        for (auto c : address)
-        {
-            switch (state)
-            {
-            case 0: {  // not in a group yet
-                if (DIGIT.Contains(c))
-                {
-                    octetBuffer.push_back(c);
-                    state = 1;
-                } else
-                { return false; }
-            }
-            break;
+    constexpr uint8_t ElementBit(EncodedElement element) { return (uint8_t)(1 << element); }
 
-            case 1: {  // expect a digit or dot
-                if (c == '.')
-                {
-                    if (numGroups++ >= 4)
-                    { return false; }
-                    if (!ValidateOctet(octetBuffer))
-                    { return false; }
-                    octetBuffer.clear();
-                    state = 0;
-                } else if (DIGIT.Contains(c))
-                {
-                    octetBuffer.push_back(c);
-                } else
-                { return false; }
-            }
-            break;
-            }
+    /**
+     * This is the set of every encoded element.
+     */
+    constexpr uint8_t ALL_ENCODED_ELEMENTS = (uint8_t)((1 << ENCODED_ELEMENT_COUNT) - 1);
+
+    /**
+     * This holds the user information element inside a URI,
+     * allocated from the memory resource of the URI.
+     */
+    struct StoredUserInfo
+    {
+        explicit StoredUserInfo(std::pmr::memory_resource* resource)
+            : name(resource), pass(resource) {}
+
+        std::pmr::string name;
+        std::pmr::string pass;
+
+        void clear() {
+            name.clear();
+            pass.clear();
         }
-        if (!octetBuffer.empty())
-        {
-            ++numGroups;
-            if (!ValidateOctet(octetBuffer))
-            { return false; }
+
+        bool operator==(const StoredUserInfo& other) const {
+            return ((name == other.name) && (pass == other.pass));
         }
-        return (numGroups == 4);
-    }
+    };
+
     /**
-     * This function checks to make sure that the address
-     * is a valid IPv6 address according to RFC 3986
-     *
-     * @param[in] address
-     *      This is an IPv6Address to validate
-     * @return
-     *      return an indication of whether or not the address
-     *      is a valid IPv6 address.
+     * This class measures how many characters the rendering
+     * of a URI takes, without writing any of them.
      */
-    bool ValidateIPv6Address(const std::string& address) {
-        size_t numGroups = 0;
-        bool doubleColonEncountered = false;
-        size_t numDigits = 0;
-        size_t state = 0;
-        std::string octetBuffuer;
-        size_t potentialIPv4AddressStart = 0;
-        size_t position = 0;
-        bool ipv4AddressEncountered = false;
-        for (auto c : address)
-        {
-            switch (state)
+    class LengthCounter
+    {
+    public:
+        void Append(char) { ++length_; }
+
+        void Append(std::string_view characters) { length_ += characters.length(); }
+
+        void AppendLowerCase(std::string_view characters) { length_ += characters.length(); }
+
+        void AppendEncoded(std::string_view element, const Uri::CharacterSet& allowedCharacters) {
+            size_t position = 0;
+            for (;;)
             {
-            case 0: {  // not in a group yet
-                if (c == ':')
-                {
-                    state = 1;
-                } else if (DIGIT.Contains(c))
-                {
-                    potentialIPv4AddressStart = position;
-                    ++numDigits = 1;
-                    state = 4;
-                } else if (HEXDIGIT.Contains(c))
-                {
-                    ++numDigits = 1;
-                    state = 3;
-                } else
-                { return false; }
+                const auto run = Uri::FindFirstNotInSet(
+                    allowedCharacters, element.data() + position, element.length() - position);
+                length_ += run;
+                position += run;
+                if (position == element.length())
+                { break; }
+                length_ += 3;
+                ++position;
             }
-            break;
+        }
 
-            case 1: {  // not in a group yet, encountered one colon
-                if (c == ':')
-                {
-                    if (doubleColonEncountered)
-                    {
-                        return false;
-                    } else
-                    {
-                        doubleColonEncountered = true;
-                        state = 2;
-                    }
-                } else
-                { return false; }
-            }
-            break;
+        size_t GetLength() const { return length_; }
 
-            case 2: {  // expect a hex digit
-                if (DIGIT.Contains(c))
-                {
-                    potentialIPv4AddressStart = position;
-                    if (++numDigits > 4)
-                    { return false; }
-                    state = 4;
-                } else if (HEXDIGIT.Contains(c))
-                {
-                    if (++numDigits > 4)
-                    { return false; }
-                    state = 3;
-                } else
-                { return false; }
-            }
-            break;
+    private:
+        size_t length_ = 0;
+    };
 
-            case 3: {  // expect either a hex digit or colon
-                if (c == ':')
-                {
-                    numDigits = 0;
-                    ++numGroups;
-                    state = 5;
-                } else if (HEXDIGIT.Contains(c))
-                {
-                    if (++numDigits > 4)
-                    { return false; }
-                } else
-                { return false; }
-            }
-            break;
+    /**
+     * This class writes the rendering of a URI into a buffer
+     * which is known to be large enough to hold it.
+     */
+    class BufferWriter
+    {
+    public:
+        explicit BufferWriter(char* buffer) : next_(buffer) {}
 
-            case 4: {  // expect either a hex digit, dot, or colon
-                if (c == ':')
-                {
-                    numDigits = 0;
-                    ++numGroups;
-                    state = 2;
-                } else if (c == '.')
-                {
-                    ipv4AddressEncountered = true;
-                    break;
-                } else if (DIGIT.Contains(c))
-                {
-                    if (++numDigits > 4)
-                    { return false; }
-                } else if (HEXDIGIT.Contains(c))
-                {
-                    if (++numDigits > 4)
-                    { return false; }
-                    state = 3;
-                } else
-                { return false; }
-            }
-            break;
+        void Append(char c) { *next_++ = c; }
 
-            case 5: {
-                if (c == ':')
-                {
-                    if (doubleColonEncountered)
-                    {
-                        return false;
-                    } else
-                    {
-                        doubleColonEncountered = true;
-                        state = 2;
-                    }
-                } else if (DIGIT.Contains(c))
-                {
-                    potentialIPv4AddressStart = position;
-                    ++numDigits;
-                    state = 4;
-                } else if (HEXDIGIT.Contains(c))
-                {
-                    ++numDigits;
-                    state = 3;
-                } else
-                { return false; }
-            }
-            break;
-            }
-            if (ipv4AddressEncountered)
-            { break; }
-            ++position;
-        }
-        if ((state == 4) || (state == 3))
-        { ++numGroups; }
-        if (((state == 1) || (state == 2) || (state == 5)) && position == address.length())
-        {  // trailing single colon
-            return false;
-        }
-        if (ipv4AddressEncountered)
-        {
-            if (!ValidateIPv4Address(address.substr(potentialIPv4AddressStart)))
-            { return false; }
-            numGroups += 2;
+        void Append(std::string_view characters) {
+            memcpy(next_, characters.data(), characters.length());
+            next_ += characters.length();
         }
-        if (doubleColonEncountered)
-        {
-            // A double clon matches one or more groups
-            return (numGroups <= 7);
-        } else
-        { return (numGroups == 8); }
 
-        return true;
-    }
+        void AppendLowerCase(std::string_view characters) {
+            for (auto c : characters)
+            { *next_++ = ((c >= 'A') && (c <= 'Z')) ? (char)(c - 'A' + 'a') : c; }
+        }
 
-    /**
-     * This function returns a strategy function that
-     * my be used with the FailsMatch function to test a scheme
-     * and make sure it is legal according to the standard.
-     *
-     * @return
-     *      returns a strategy function that
-     *      my be used with the FailsMatch function to test a scheme
-     *      and make sure it is legal according to the standard.
-     */
-    std::function<bool(char, bool)> LegalSchemeStartegy() {
-        auto isFirstCharacter = std::make_shared<bool>(true);
-        return [isFirstCharacter](char c, bool end)
-        {
-            if (end)
+        void AppendEncoded(std::string_view element, const Uri::CharacterSet& allowedCharacters) {
+            size_t position = 0;
+            for (;;)
             {
-                return !*isFirstCharacter;
-            } else
-            {
-                bool check;
-                if (*isFirstCharacter)
-                {
-                    check = ALPHA.Contains(c);
-                } else
-                { check = SCHEME_NOT_FIRST.Contains(c); }
-                *isFirstCharacter = false;
-                return check;
+                // Copy the run of characters which need no encoding in one go.
+                const auto run = Uri::FindFirstNotInSet(
+                    allowedCharacters, element.data() + position, element.length() - position);
+                Append(element.substr(position, run));
+                position += run;
+                if (position == element.length())
+                { break; }
+                const auto c = (unsigned char)element[position++];
+                *next_++ = '%';
+                *next_++ = Uri::HEX_DIGITS[c >> 4];
+                *next_++ = Uri::HEX_DIGITS[c & 0x0F];
             }
-        };
-    }
+        }
 
+    private:
+        char* next_;
+    };
 }  // namespace
 
 namespace Uri
@@ -399,20 +355,48 @@ namespace Uri
 
     struct Uri::Impl
     {
+        /**
+         * This constructs the properties of an empty Uri.
+         *
+         * @param[in] resource
+         *      This is the memory resource from which to allocate
+         *      every element of the Uri.
+         */
+        explicit Impl(std::pmr::memory_resource* resource)
+            : scheme(resource), host(resource), path(resource), query(resource),
+              fragment(resource), userInfo(resource), encoded(resource),
+              rendered{std::pmr::string(resource), std::pmr::string(resource),
+                       std::pmr::string(resource), std::pmr::string(resource)} {}
+
         /**
          * This is the scheme elemen of the Uri.
          */
-        std::string scheme;
+        std::pmr::string scheme;
 
         /**
          * This is the host element of the Uri.
          */
-        std::string host;
+        std::pmr::string host;
+
+        /**
+         * This is the kind of the host, which tells how to render
+         * and compare it.
+         */
+        HostKind hostKind = HostKind::RegName;
+
+        /**
+         * This is the numeric address of the host, if it is one.
+         */
+        HostAddress hostAddress;
 
         /**
-         * This is the path elements vector of the Uri.
+         * This holds the path segments of the Uri.
+         *
+         * It, the query, the fragment and the user info are mutable
+         * since a lazily parsed Uri decodes them the first time
+         * they are read.
          */
-        std::vector<std::string> path;
+        mutable PathStorage path;
 
         /**
          * This is the port element of the Uri.
@@ -427,7 +411,7 @@ namespace Uri
         /**
          * This is the query element of the Uri.
          */
-        std::string query;
+        mutable std::pmr::string query;
 
         /**
          * This is an indication of whether or not the Uri has a query.
@@ -442,388 +426,299 @@ namespace Uri
         /**
          * This is the fragment element of the Uri.
          */
-        std::string fragment;
+        mutable std::pmr::string fragment;
 
         /**
          * This is the User info structure.
          */
-        UserInfo userInfo;
+        mutable StoredUserInfo userInfo;
+
+        /**
+         * This is the hash of the Uri, once computed.  Every method
+         * which changes an element of the Uri must reset it.
+         */
+        CachedHash hash;
+
+        /**
+         * This holds the encoded form of the elements in the
+         * hasEncoded set, at the ranges in encodedRanges.  A lazy
+         * parse fills it with a copy of the URI string.
+         */
+        mutable std::pmr::string encoded;
+
+        /**
+         * This is where the encoded form of each element lies
+         * in the encoded string.
+         */
+        mutable ComponentRange encodedRanges[ENCODED_ELEMENT_COUNT];
+
+        /**
+         * These hold the encoded form of the elements in the
+         * isRendered set, each rendered from the decoded element
+         * the first time it was asked for.  Each element has its
+         * own, so that rendering one never moves the others.
+         */
+        mutable std::pmr::string rendered[ENCODED_ELEMENT_COUNT];
+
+        /**
+         * This is the set of elements whose encoded form is held.
+         */
+        mutable uint8_t hasEncoded = 0;
+
+        /**
+         * This is the set of elements whose encoded form is held
+         * in rendered rather than in encoded.  It is always part
+         * of hasEncoded.
+         */
+        mutable uint8_t isRendered = 0;
+
+        /**
+         * This is the set of elements kept encoded by a lazy parse
+         * and not decoded yet.  It is always part of hasEncoded.
+         */
+        mutable uint8_t pending = 0;
 
         // Methods
+
         /**
-         * This method checks and decodes the given URI element.
+         * This method decodes those of the given elements which
+         * a lazy parse left encoded.
          *
-         * @param[in, out] element
-         *      On input, this is the uri element to check and decode.
-         *      On output, this is the decoded element.
-         * @param[in] allowedCharacters
-         *      This is the set of characters tha do not need to
-         *      be percent-encoded.
-         * @return
-         *      return an indication of whether or not the element
-         *      passed all checks and was decoded successfully.
+         * @param[in] elements
+         *      This is the set of elements to decode.
          */
-        bool DecodeElement(std::string& element, const CharacterSet& charachterSetAllowed) {
-            const auto entryElement = std::move(element);
-            element.clear();
-            bool decodingPec = false;
-            PercentEncodedCharacterDecoder pDecoder;
-            for (const auto c : entryElement)
+        void Decode(uint8_t elements) const {
+            const auto todo = (uint8_t)(pending & elements);
+            if (todo == 0)
+            { return; }
+            pending &= (uint8_t)~todo;
+
+            // Every element left encoded was checked while parsing,
+            // so decoding it can't fail.
+            if ((todo & ElementBit(USER_INFO_ELEMENT)) != 0)
             {
-                if (decodingPec)
+                const auto rawUserInfo = Slice(encoded, encodedRanges[USER_INFO_ELEMENT]);
+                const auto userInfoDelimiter = rawUserInfo.find(':');
+                (void)DecodeElement(rawUserInfo.substr(0, userInfoDelimiter), USER_INFO_CHAR,
+                                    userInfo.name);
+                if (userInfoDelimiter == std::string_view::npos)
                 {
-                    if (!pDecoder.NextEncodedCharacter(c))
-                    { return false; }
-                    if (pDecoder.Done())
-                    {
-                        decodingPec = false;
-                        element.push_back((char)pDecoder.GetDecodedCharacter());
-                    }
+                    userInfo.pass.clear();
                 } else
                 {
-                    if (c == '%')
-                    {
-                        decodingPec = true;
-                        pDecoder = PercentEncodedCharacterDecoder();
-                    } else
-                    {
-                        if (charachterSetAllowed.Contains(c))
-                        {
-                            element.push_back(c);
-                        } else
-                        { return false; }
-                    }
+                    (void)DecodeElement(rawUserInfo.substr(userInfoDelimiter + 1), USER_INFO_CHAR,
+                                        userInfo.pass);
                 }
             }
-            return true;
+            if ((todo & ElementBit(PATH_ELEMENT)) != 0)
+            { (void)path.Parse(Slice(encoded, encodedRanges[PATH_ELEMENT])); }
+            if ((todo & ElementBit(QUERY_ELEMENT)) != 0)
+            {
+                (void)DecodeElement(Slice(encoded, encodedRanges[QUERY_ELEMENT]),
+                                    QUERY_OR_FRAGMENT_CHAR, query);
+            }
+            if ((todo & ElementBit(FRAGMENT_ELEMENT)) != 0)
+            {
+                (void)DecodeElement(Slice(encoded, encodedRanges[FRAGMENT_ELEMENT]),
+                                    QUERY_OR_FRAGMENT_CHAR, fragment);
+            }
         }
+
         /**
-         * This fucntion returns the hex digit that corresponds
-         * to the given value.
+         * This method forgets the encoded form of the given element,
+         * which is about to be changed.  The element must have been
+         * decoded already.
          *
-         * @param[in] value
-         *      This is the value to convert to a hex digit.
-         * @return
-         *      The hex digit corresponding to the given value is returned.
+         * @param[in] element
+         *      This is the element being changed.
          */
-        char MakeHexDigit(int value) {
-            if (value < 10)
-            {
-                return (char)(value + '0');
-            } else
-            { return (char)(value - 10 + 'A'); }
+        void DropEncoded(EncodedElement element) {
+            pending &= (uint8_t)~ElementBit(element);
+            hasEncoded &= (uint8_t)~ElementBit(element);
+            isRendered &= (uint8_t)~ElementBit(element);
         }
+
         /**
-         * This method encodes the given URI element.
+         * This method rewrites the encoded form of the given element,
+         * if it is held, in place: percent-encoded unreserved characters
+         * are decoded, and the hex digits of the other percent-encodings
+         * are made uppercase.  The decoded element is unchanged.
+         * A rendered form is already normalized.
          *
          * @param[in] element
-         *      On input, this is the element to encode.
-         * @param[in] allowedCharacters
-         *      This is the set of characters tha do not need to
-         *      be decoded
-         * @return
-         *      return the encoded element.
+         *      This is the element whose encoded form to normalize.
          */
-        std::string EncodeElement(const std::string& element,
-                                  const CharacterSet& allowedCharacters) {
-            std::string encodedElement;
-            for (auto c : element)
-            {
-                if (allowedCharacters.Contains(c))
-                {
-                    encodedElement.push_back(c);
-                } else
-                {
-                    encodedElement.push_back('%');
-                    encodedElement.push_back(MakeHexDigit((unsigned int)c >> 4));
-                    encodedElement.push_back(MakeHexDigit((unsigned int)c & 0x0F));
-                }
-            }
-            return encodedElement;
+        void NormalizeEncoded(EncodedElement element) {
+            if (((hasEncoded & ~isRendered) & ElementBit(element)) == 0)
+            { return; }
+            auto& range = encodedRanges[element];
+            DecodingOptions options;
+            options.decodedCharacters = &UNRESERVED;
+            options.keepMalformed = true;
+            range.length = PercentEncodedCharacterDecoder::Decode(
+                Slice(encoded, range), &encoded[range.offset], options);
         }
 
         /**
-         * This method checks and decode query or fragment elements of
-         * a String Uri.
+         * This method returns the path, decoded and with its encoded
+         * form dropped, ready to be changed in place.
          *
-         * @param[in, out] queryOrFragment
-         *      On input, we have the Query or Fragment element to check and decode.
-         *      On output, we have the decoded Query or Fragment element
          * @return
-         *      return an indication of whether or not the element
-         *      passed all checks and was decoded
+         *      The path is returned.
          */
-        bool DecodeQueryOrFragment(std::string& queryOrFragment) {
-            if (!DecodeElement(queryOrFragment, QUERY_OR_FRAGMENT_CHAR))
-            { return false; }
-            return true;
+        PathStorage& EditPath() {
+            Decode(ElementBit(PATH_ELEMENT));
+            DropEncoded(PATH_ELEMENT);
+            hash.Reset();
+            return path;
         }
 
-        /**.
-         * This method checks and decode the path segment.
+        /**
+         * This method returns the encoded form of the given element,
+         * rendering it from the decoded element if it isn't held.
+         * Rendering one element leaves the encoded forms of the
+         * others where they are.
          *
-         * @param[in, out] segment
-         *      On input, this is the path segment to check and decode.
-         *      On output, this is the decoded path segment.
+         * @param[in] element
+         *      This is the element whose encoded form to return.
          * @return
-         *      return an indication of whether or not the path segment
-         *      passed all checks and was decoded successfully.
+         *      The encoded form of the element is returned.
          */
-        bool DecodePathSegment(std::string& segment) {
-            if (!DecodeElement(segment, PCHAR_NOT_PCT_ENCODED))
-            { return false; }
-            return true;
+        std::string_view GetEncoded(EncodedElement element) const {
+            if ((hasEncoded & ElementBit(element)) == 0)
+            {
+                auto& form = rendered[element];
+                LengthCounter counter;
+                GenerateElement(element, counter);
+                form.resize(counter.GetLength());
+                BufferWriter writer(form.data());
+                GenerateElement(element, writer);
+                hasEncoded |= ElementBit(element);
+                isRendered |= ElementBit(element);
+            }
+            if ((isRendered & ElementBit(element)) != 0)
+            { return rendered[element]; }
+            return Slice(encoded, encodedRanges[element]);
         }
 
         /**
-         * This method builds the internal path element sequence
-         * by parsing it from the given path string.
-         *
-         * @param[in] pathString
-         *      This is the whole path of the Uri.
+         * This method checks whether or not the host of the Uri is the
+         * same as the host of the given one.  IPv6 addresses are compared
+         * by their numeric form, since one has several text forms.
          *
+         * @param[in] other
+         *      This is the other Uri whose host is compared.
          * @return
-         *      An indication if the path was parsed correctly or not
+         *      An indication of whether or not the hosts are the same
          *      is returned.
          */
-        bool ParsePath(std::string& pathString) {
-            path.clear();
-            if (pathString == "/")
-            {
-                // Special case of an empty path.
-                path.push_back("");
-                pathString.clear();
-            } else if (!pathString.empty())
-            {
-                for (;;)
-                {
-                    auto delimiter = pathString.find('/');
-                    if (delimiter == std::string::npos)
-                    {
-                        path.push_back(pathString);
-                        pathString.clear();
-                        break;
-                    } else
-                    {
-                        path.emplace_back(pathString.begin(), pathString.begin() + delimiter);
-                        pathString = pathString.substr(delimiter + 1);
-                    }
-                }
-                if (!path.empty())
-                {
-                    for (auto& segment : path)
-                    {
-                        if (!DecodePathSegment(segment))
-                        { return false; }
-                    }
-                }
-            }
+        bool HasSameHost(const Impl& other) const {
+            if (hostKind != other.hostKind)
+            { return false; }
+            if (hostKind == HostKind::IPv6)
+            { return (memcmp(hostAddress.ipv6, other.hostAddress.ipv6, 16) == 0); }
+            return (host == other.host);
+        }
 
-            return true;
+        /**
+         * This method computes the hash of the Uri from its elements,
+         * mixing in only what operator== compares.
+         *
+         * @return
+         *      The hash of the Uri is returned.
+         */
+        size_t ComputeHash() const {
+            const std::hash<std::string_view> hashString;
+            auto result = hashString(scheme);
+            result = CombineHash(result, hashString(userInfo.name));
+            result = CombineHash(result, hashString(userInfo.pass));
+            result = CombineHash(result, (hostKind == HostKind::IPv6)
+                                             ? hashString(std::string_view(
+                                                   (const char*)hostAddress.ipv6,
+                                                   sizeof(hostAddress.ipv6)))
+                                             : hashString(host));
+            result = CombineHash(result, hasPort ? ((size_t)port + 1) : 0);
+            result = CombineHash(result, path.GetSegmentCount());
+            result = CombineHash(result, hashString(path.GetBuffer()));
+            result = CombineHash(result, hasQuery ? (hashString(query) + 1) : 0);
+            result = CombineHash(result, hasFragment ? (hashString(fragment) + 1) : 0);
+            return result;
         }
 
         /**
          * This method parses the elemnets that  make up the authority
          * composite section of the Uri.
          *
-         * @param[in] authority
-         *      This is the string containing the whole authority part of the Uri.
+         * @param[in] uriString
+         *      This is the whole URI string.
+         * @param[in] layout
+         *      This is the location of each element in the URI string.
+         * @param[in] components
+         *      These are the elements to parse.  The others are cleared.
+         * @param[in] decoding
+         *      This is how to decode the user info.
          *
          * @return
-         *      An indication if the
-         *
+         *      An indication if the authority was parsed correctly or not
+         *      is returned.
          */
-        bool ParseAuthority(std::string& authorityString) {
+        bool ParseAuthority(std::string_view uriString, const ComponentLayout& layout,
+                            ComponentMask components, Decoding decoding) {
             // user info parse
-            auto userInfoEnd = authorityString.find('@');
-            if (userInfoEnd == std::string::npos)
+            const bool parseUserInfo =
+                (layout.hasUserInfo && HasAnyOf(components, ComponentMask::UserInfo));
+            if (parseUserInfo && (decoding == Decoding::Lazy))
             {
-                userInfo.name.clear();
-                userInfo.pass.clear();
-            } else
+                if (!ValidateElement(Slice(uriString, layout.userInfo), USER_INFO_CHAR))
+                { return false; }
+                userInfo.clear();
+            } else if (parseUserInfo)
             {
-                std::string uriUserInfo = authorityString.substr(0, userInfoEnd);
-                size_t decoderState = 0;
-                std::string userInfodecoded;
-                int decodedCharacter = 0;
-                PercentEncodedCharacterDecoder pDecoder;
-                // State Machine pattern
-                for (const auto c : uriUserInfo)
-                {
-                    switch (decoderState)
-                    {
-                    case 0: {
-                        if (c == '%')
-                        {
-                            decoderState = 1;
-                            pDecoder = PercentEncodedCharacterDecoder();
-                        } else
-                        {
-                            if (USER_INFO_CHAR.Contains(c))
-                            {
-                                userInfodecoded.push_back(c);
-                            } else
-                            { return false; }
-                        }
-                    }
-                    break;
-
-                    case 1: {
-                        if (!pDecoder.NextEncodedCharacter(c))
-                        { return false; }
-                        if (pDecoder.Done())
-                        {
-                            decoderState = 0;
-                            userInfodecoded.push_back((char)pDecoder.GetDecodedCharacter());
-                        }
-                    }
-                    break;
-                    }
-                }
-                const auto userInfoDelimiter = userInfodecoded.find(':');
-                if (userInfoDelimiter == std::string::npos)
-                {
-                    userInfo.name = userInfodecoded;
-                } else
+                const auto uriUserInfo = Slice(uriString, layout.userInfo);
+                const auto userInfoDelimiter = uriUserInfo.find(':');
+                if (!DecodeElement(uriUserInfo.substr(0, userInfoDelimiter), USER_INFO_CHAR,
+                                   userInfo.name))
+                { return false; }
+                if (userInfoDelimiter == std::string_view::npos)
                 {
-                    userInfo.name = userInfodecoded.substr(0, userInfoDelimiter);
-                    userInfo.pass = userInfodecoded.substr(userInfoDelimiter + 1);
-                }
-                authorityString = authorityString.substr(userInfoEnd + 1);
-            }
+                    userInfo.pass.clear();
+                } else if (!DecodeElement(uriUserInfo.substr(userInfoDelimiter + 1),
+                                          USER_INFO_CHAR, userInfo.pass))
+                { return false; }
+            } else
+            { userInfo.clear(); }
 
-            auto authorityEnd = authorityString.find('/');
-            if (authorityEnd == std::string::npos)
-            {
-                authorityEnd = authorityString.find('?');
-                if (authorityEnd == std::string::npos)
-                {
-                    authorityEnd = authorityString.find('#');
-                    if (authorityEnd == std::string::npos)
-                    { authorityEnd = authorityString.length(); }
-                }
-            }
             // host parse
-            // const auto portDelimiter = authorityString.find(':');
-            std::string hostName, portString;
-            hostName = authorityString.substr(0, authorityEnd);
-            std::string encodedHostName;
-            size_t decoderState = 0;
-            PercentEncodedCharacterDecoder pDecoder;
-            int decodedCharacter = 0;
-            bool isRegChar = false;
-            for (const auto c : hostName)
+            const auto hostString = Slice(uriString, layout.host);
+            if (!HasAnyOf(components, ComponentMask::Host))
             {
-                switch (decoderState)
+                host.clear();
+                hostKind = HostKind::RegName;
+                hostAddress = HostAddress();
+            } else if (!layout.hostIsIpLiteral)
+            {  // reg-name or IPv4Address
+                if (!DecodeElement(hostString, REG_NAME_NOT_PCT_ENCODED, host))
+                { return false; }
+                LowerCaseInPlace(host);
+                hostKind = HostKind::RegName;
+                hostAddress = HostAddress();
+                if (ParseIPv4Address(host, hostAddress.ipv4))
                 {
-                case 0: {  // first character
-                    if (c == '[')
-                    {
-                        decoderState = 4;
-                        break;
-                    } else
-                    {
-                        decoderState = 1;
-                        isRegChar = true;
-                    }
-                }
-
-                case 1: {  // reg-name or IPv4Address
-                    if (c == '%')
-                    {
-                        pDecoder = PercentEncodedCharacterDecoder();
-                        decoderState = 2;
-                    } else if (c == ':')
-                    {
-                        decoderState = 9;
-                    } else
-                    {
-                        if (USER_INFO_CHAR.Contains(c))
-                        {
-                            encodedHostName.push_back(c);
-                        } else
-                        { return false; }
-                    }
-                }
-                break;
-
-                case 2: {
-                    if (!pDecoder.NextEncodedCharacter(c))
-                    { return false; }
-                    if (pDecoder.Done())
-                    {
-                        decoderState = 1;
-                        encodedHostName.push_back((char)pDecoder.GetDecodedCharacter());
-                    }
-                }
-                break;
-
-                case 4: {  // IP-literal
-                    if (c == 'v')
-                    {
-                        decoderState = 6;
-                        encodedHostName.push_back(c);
-                        break;
-                    } else
-                    { decoderState = 5; }
-                }
-
-                case 5: {  // IPv6Address
-                    // TODO: Later
-
-                    if (c == ']')
-                    {
-                        if (!ValidateIPv6Address(encodedHostName))
-                        { return false; }
-                        decoderState = 8;
-                    } else
-                    { encodedHostName.push_back(c); }
-                }
-                break;
-
-                case 6: {  // IPvFuture: v
-                    if (c == '.')
-                    {
-                        decoderState = 7;
-                    } else if (!HEXDIGIT.Contains(c))
-                    { return false; }
-                    encodedHostName.push_back(c);
-                }
-                break;
-
-                case 7: {  // IPvFuture v 1*HEXDIG
-
-                    if (c == ']')
-                    {
-                        decoderState = 8;
-                    } else if (!IPV_LAST_PART_FUTURE.Contains(c))
-                    {
-                        return false;
-                    } else
-                    { encodedHostName.push_back(c); }
-                }
-                break;
-
-                case 8: {  // we can't have anithing else, unless it's a colon,
-                           // in which case it's a port delimiter
-                    if (c == ':')
-                    {
-                        decoderState = 9;
-                    } else
-                    { return false; }
-                }
-                break;
-
-                case 9: {  // port
-                    portString.push_back(c);
-                }
-                break;
+                    hostKind = HostKind::IPv4;
+                    hostAddress.family = AddressFamily::IPv4;
                 }
+            } else
+            {  // IPv6Address or IPvFuture
+                if (!ParseIpLiteral(hostString, hostAddress))
+                { return false; }
+                hostKind = (hostAddress.family == AddressFamily::IPv6) ? HostKind::IPv6
+                                                                        : HostKind::IPvFuture;
+                host.assign(hostString);
             }
-            if ((decoderState != 0) && (decoderState != 1) && (decoderState != 8) &&
-                (decoderState != 9))
-            { return false; }
-            if (portString.empty())
+
+            // port parse
+            const auto portString = Slice(uriString, layout.port);
+            if (portString.empty() || !HasAnyOf(components, ComponentMask::Port))
             {
                 hasPort = false;
             } else
@@ -832,69 +727,120 @@ namespace Uri
                 { return false; }
                 hasPort = true;
             }
-            if (isRegChar)
-            {
-                host = StringUtils::NormalizeCaseInsensitiveString(encodedHostName);
-            } else
-            { host = encodedHostName; }
-
-            authorityString = authorityString.substr(authorityEnd);
             return true;
         }
+
         /**
-         * This method parse fragment from uri string part
+         * This method renders the URI into the given output, encoding
+         * each element as needed.
          *
-         * @param[in, out] elements
-         *      The part of uri string containing fragment element
-         * @return
-         *      return an indication of whether or not the fragment was extracted
-         *      from the uri string part.
+         * @param[in, out] output
+         *      This is where to render the URI.  It is either a
+         *      LengthCounter, to measure the rendering, or a
+         *      BufferWriter, to write it.
          */
-        bool ParseFragment(std::string& elements) {
-            const auto fragmentDelimiter = elements.find('#');
-            if (fragmentDelimiter == std::string::npos)
+        template <typename Output> void Generate(Output& output) const {
+            if (!scheme.empty())
             {
-                hasFragment = false;
-                fragment.clear();
-            } else
+                output.Append(scheme);
+                output.Append(':');
+            }
+            if (!host.empty())
+            {
+                output.Append("//");
+                if (!userInfo.name.empty())
+                {
+                    GenerateElement(USER_INFO_ELEMENT, output);
+                    output.Append('@');
+                }
+                switch (hostKind)
+                {
+                case HostKind::IPv6: {
+                    // The address is rendered from its numeric form,
+                    // in the canonical text of RFC 5952.
+                    char text[IPV6_TEXT_SIZE];
+                    output.Append('[');
+                    output.Append(FormatIPv6Address(hostAddress.ipv6, text));
+                    output.Append(']');
+                }
+                break;
+
+                case HostKind::IPvFuture: {
+                    output.Append('[');
+                    output.Append(host);
+                    output.Append(']');
+                }
+                break;
+
+                default: {
+                    output.AppendEncoded(host, REG_NAME_NOT_PCT_ENCODED);
+                }
+                break;
+                }
+                if (hasPort && (port > 0))
+                {
+                    char digits[5];
+                    output.Append(':');
+                    output.Append(FormatPort(port, digits));
+                }
+            }
+            GenerateElement(PATH_ELEMENT, output);
+            if (hasQuery)
             {
-                hasFragment = true;
-                fragment = elements.substr(fragmentDelimiter + 1);
+                output.Append('?');
+                GenerateElement(QUERY_ELEMENT, output);
+            }
+            if (hasFragment)
+            {
+                output.Append('#');
+                GenerateElement(FRAGMENT_ELEMENT, output);
             }
-            if (!DecodeQueryOrFragment(fragment))
-            { return false; }
-            return true;
         }
 
         /**
-         * This method parse query element from uri string part
+         * This method renders one element of the URI into the given
+         * output, encoding it as needed.  The element must have been
+         * decoded already.
          *
-         * @param[in, out] elements
-         *      The part of uri string containing query element
-         * @return
-         *      return an indication of whether or not the query was extracted
-         *      from the uri string part.
+         * @param[in] element
+         *      This is the element to render.
+         * @param[in, out] output
+         *      This is where to render the element.
          */
-        bool ParseQuery(std::string& elements) {
-            const auto queryDelimiter = elements.find('?');
-            const auto fragmentDelimiter = elements.find('#');
-            if (queryDelimiter == std::string::npos)
-            {
-                hasQuery = false;
-                query.clear();
-            } else
+        template <typename Output>
+        void GenerateElement(EncodedElement element, Output& output) const {
+            switch (element)
             {
-                if (fragmentDelimiter != std::string::npos)
+            case USER_INFO_ELEMENT: {
+                output.AppendEncoded(userInfo.name, USER_INFO_CHAR);
+                if (!userInfo.pass.empty())
                 {
-                    query =
-                        elements.substr(queryDelimiter + 1, fragmentDelimiter - queryDelimiter - 1);
-                } else
-                { query = elements.substr(queryDelimiter + 1); }
-                hasQuery = true;
+                    output.Append(':');
+                    output.AppendEncoded(userInfo.pass, USER_INFO_CHAR);
+                }
+            }
+            break;
+
+            case PATH_ELEMENT: {
+                if (IsPathAbsolute() && (path.GetSegmentCount() == 1))
+                { output.Append('/'); }
+                path.Generate(output);
+            }
+            break;
+
+            case QUERY_ELEMENT: {
+                output.AppendEncoded(query, QUERY_OR_FRAGMENT_CHAR);
+            }
+            break;
+
+            case FRAGMENT_ELEMENT: {
+                output.AppendEncoded(fragment, QUERY_OR_FRAGMENT_CHAR);
+            }
+            break;
+
+            default:
+                break;
             }
-            if (!DecodeQueryOrFragment(query))
-            { return false; }
-            return true;
         }
 
         /**
@@ -907,7 +853,9 @@ namespace Uri
          *     An indication of whether or not it makes sense to
          *     navigate one level up from the current path is returned.
          */
-        bool CanNavigatePathUpOneLevel() const { return (!IsPathAbsolute() || (path.size() > 1)); }
+        bool CanNavigatePathUpOneLevel() const {
+            return (!IsPathAbsolute() || (path.GetSegmentCount() > 1));
+        }
         /**
          * This method returns an indication of whether or not the
          * path of the URI is an absolute path, meaning it begins
@@ -918,158 +866,466 @@ namespace Uri
          *     is an absolute path, meaning it begins
          *     with a forward slash ('/') character is returned.
          */
-        bool IsPathAbsolute() const { return (!path.empty() && (path[0] == "")); }
+        bool IsPathAbsolute() const { return (!path.IsEmpty() && path.GetFirstSegment().empty()); }
     };
 
+    void Uri::ImplDeleter::operator()(Impl* impl) const {
+        const auto resource = impl->scheme.get_allocator().resource();
+        impl->~Impl();
+        resource->deallocate(impl, sizeof(Impl), alignof(Impl));
+    }
+
     Uri::~Uri() = default;
-    Uri::Uri(const Uri& other) : impl_(new Impl) { *this = other; }
-    Uri::Uri(Uri&&) = default;
+    Uri::Uri(const Uri& other) : Uri(other, std::pmr::get_default_resource()) {}
+    Uri::Uri(Uri&&) noexcept = default;
     Uri& Uri::operator=(const Uri& other) {
         if (this != &other)
         { *impl_ = *other.impl_; }
         return *this;
     }
-    Uri& Uri::operator=(Uri&&) = default;
-    Uri::Uri() : impl_(new Impl) {}
+    Uri& Uri::operator=(Uri&&) noexcept = default;
+    Uri::Uri() : Uri(std::pmr::get_default_resource()) {}
+
+    Uri::Uri(std::pmr::memory_resource* resource)
+        : impl_(new (resource->allocate(sizeof(Impl), alignof(Impl))) Impl(resource)) {}
+
+    Uri::Uri(const Uri& other, std::pmr::memory_resource* resource) : Uri(resource) {
+        *impl_ = *other.impl_;
+    }
+
+    std::pmr::memory_resource* Uri::GetMemoryResource() const {
+        return impl_->scheme.get_allocator().resource();
+    }
 
     bool Uri::operator==(const Uri& other) const {
-        return ((impl_->scheme == other.GetScheme()) && (impl_->userInfo == other.GetUserInfo()) &&
-                (impl_->host == other.GetHost()) &&
-                ((!impl_->hasPort && !other.HasPort()) ||
-                 (impl_->hasPort && other.HasPort()) && (impl_->port == other.GetPort())) &&
-                (impl_->query == other.GetQuery()) && (impl_->fragment == other.GetFragment()) &&
-                (impl_->path == other.GetPath()));
+        // The flags and the port are checked first, since they
+        // are the cheapest to compare and the most likely to differ.
+        // Each string comparison checks the lengths before any characters.
+        const auto& lhs = *impl_;
+        const auto& rhs = *other.impl_;
+        lhs.Decode(ALL_ENCODED_ELEMENTS);
+        rhs.Decode(ALL_ENCODED_ELEMENTS);
+        if ((lhs.hasPort != rhs.hasPort) || (lhs.hasPort && (lhs.port != rhs.port)) ||
+            (lhs.hasQuery != rhs.hasQuery) || (lhs.hasFragment != rhs.hasFragment) ||
+            (lhs.path.GetSegmentCount() != rhs.path.GetSegmentCount()))
+        { return false; }
+        return (lhs.HasSameHost(rhs) && (lhs.scheme == rhs.scheme) &&
+                (!lhs.hasQuery || (lhs.query == rhs.query)) &&
+                (!lhs.hasFragment || (lhs.fragment == rhs.fragment)) &&
+                (lhs.userInfo == rhs.userInfo) && (lhs.path == rhs.path));
     }
 
     bool Uri::operator!=(const Uri& other) const { return !(*this == other); }
 
-    bool Uri::ParseFromString(const std::string& uriString) {
-        auto authorityOrPathDelimiter = uriString.find('/');
-        if (authorityOrPathDelimiter == std::string::npos)
-        { authorityOrPathDelimiter = uriString.length(); }
+    size_t Uri::GetHash() const {
+        auto hash = impl_->hash.Get();
+        if (hash == 0)
+        {
+            impl_->Decode(ALL_ENCODED_ELEMENTS);
+            hash = impl_->ComputeHash();
+            if (hash == 0)
+            { hash = 1; }
+            impl_->hash.Set(hash);
+        }
+        return hash;
+    }
+
+    bool Uri::ParseFromString(const char* uriString, size_t length) {
+        return ParseFromString(std::string_view(uriString, length));
+    }
+
+    bool Uri::ParseFromString(std::string_view uriString) {
+        return ParseFromString(uriString, ComponentMask::All, Decoding::Eager);
+    }
+
+    bool Uri::ParseFromString(std::string_view uriString, Decoding decoding) {
+        return ParseFromString(uriString, ComponentMask::All, decoding);
+    }
+
+    bool Uri::ParseFromString(std::string_view uriString, ComponentMask components,
+                              Decoding decoding) {
+        impl_->hash.Reset();
+        impl_->hasEncoded = 0;
+        impl_->isRendered = 0;
+        impl_->pending = 0;
+        ComponentLayout layout;
+        if (!LocateComponents(uriString, layout, components))
+        { return false; }
 
         // scheme parse
-        const auto schemeEnd = uriString.substr(0, authorityOrPathDelimiter).find(':');
-        std::string next;
-        if (schemeEnd == std::string::npos)
+        if (layout.hasScheme && HasAnyOf(components, ComponentMask::Scheme))
         {
-            impl_->scheme.clear();
-            next = uriString;
-        } else
-        {
-            impl_->scheme = uriString.substr(0, schemeEnd);
-            if (FailsMatch(impl_->scheme, LegalSchemeStartegy()))
+            const auto scheme = Slice(uriString, layout.scheme);
+            if (!ValidateScheme(scheme))
             { return false; }
-            impl_->scheme = StringUtils::NormalizeCaseInsensitiveString(impl_->scheme);
-            next = uriString.substr(schemeEnd + 1);
-        }
+            impl_->scheme.assign(scheme);
+            LowerCaseInPlace(impl_->scheme);
+        } else
+        { impl_->scheme.clear(); }
 
-        if (next.substr(0, 2) == "//")
+        if (layout.hasAuthority)
         {
-            next = next.substr(2);
             // authority parse
-            if (!impl_->ParseAuthority(next))
+            if (!impl_->ParseAuthority(uriString, layout, components, decoding))
             { return false; }
-
         } else
         {
             // no host so neither userInfo
             impl_->userInfo.clear();
             impl_->host.clear();
+            impl_->hostKind = HostKind::RegName;
+            impl_->hostAddress = HostAddress();
             impl_->hasPort = false;
         }
-        auto pathString = next.substr(0, next.find_first_of("?#"));
+
+        // The elements which may be decoded later are only checked
+        // here, when parsing lazily, and those not empty are
+        // remembered as pending.
+        const bool lazy = (decoding == Decoding::Lazy);
+        uint8_t pending = 0;
+        if (lazy && HasAnyOf(components, ComponentMask::UserInfo) && (layout.userInfo.length > 0))
+        { pending |= ElementBit(USER_INFO_ELEMENT); }
+
         // path parse
-        if (!impl_->ParsePath(pathString))
+        const auto pathString = HasAnyOf(components, ComponentMask::Path)
+                                    ? Slice(uriString, layout.path)
+                                    : std::string_view();
+        if (lazy && !pathString.empty())
+        {
+            if ((pathString.length() > UINT32_MAX) ||
+                !ValidateElement(pathString, PATH_CHAR_NOT_PCT_ENCODED))
+            { return false; }
+            impl_->path.Clear();
+            pending |= ElementBit(PATH_ELEMENT);
+        } else
+        {
+            if (!impl_->path.Parse(pathString))
+            { return false; }
+
+            // Handle special case of absolute URI with empty
+            // path -- treat the same as "/" path.
+            if ((layout.host.length > 0) && impl_->path.IsEmpty() &&
+                HasAnyOf(components, ComponentMask::Path))
+            { impl_->path.AppendSegment(""); }
+        }
+
+        // query
+        impl_->hasQuery = (layout.hasQuery && HasAnyOf(components, ComponentMask::Query));
+        const auto queryString =
+            impl_->hasQuery ? Slice(uriString, layout.query) : std::string_view();
+        if (lazy && !queryString.empty())
+        {
+            if (!ValidateElement(queryString, QUERY_OR_FRAGMENT_CHAR))
+            { return false; }
+            pending |= ElementBit(QUERY_ELEMENT);
+        } else if (!DecodeElement(queryString, QUERY_OR_FRAGMENT_CHAR, impl_->query))
         { return false; }
 
-        // Handle special case of absolute URI with empty
-        // path -- treat the same as "/" path.
-        if (!impl_->host.empty() && impl_->path.empty())
-        { impl_->path.push_back(""); }
         // fragment
-        if (!impl_->ParseFragment(next))
+        impl_->hasFragment = (layout.hasFragment && HasAnyOf(components, ComponentMask::Fragment));
+        const auto fragmentString =
+            impl_->hasFragment ? Slice(uriString, layout.fragment) : std::string_view();
+        if (lazy && !fragmentString.empty())
+        {
+            if (!ValidateElement(fragmentString, QUERY_OR_FRAGMENT_CHAR))
+            { return false; }
+            pending |= ElementBit(FRAGMENT_ELEMENT);
+        } else if (!DecodeElement(fragmentString, QUERY_OR_FRAGMENT_CHAR, impl_->fragment))
         { return false; }
 
-        // query
-        if (!impl_->ParseQuery(next))
-        { return false; }
+        if (lazy)
+        {
+            // Keep a copy of the URI string, which holds the encoded
+            // form of every element asked for.  The others are empty.
+            impl_->encoded.assign(uriString);
+            impl_->encodedRanges[USER_INFO_ELEMENT] =
+                HasAnyOf(components, ComponentMask::UserInfo) ? layout.userInfo : ComponentRange();
+            impl_->encodedRanges[PATH_ELEMENT] =
+                HasAnyOf(components, ComponentMask::Path) ? layout.path : ComponentRange();
+            impl_->encodedRanges[QUERY_ELEMENT] =
+                impl_->hasQuery ? layout.query : ComponentRange();
+            impl_->encodedRanges[FRAGMENT_ELEMENT] =
+                impl_->hasFragment ? layout.fragment : ComponentRange();
+            impl_->hasEncoded = ALL_ENCODED_ELEMENTS;
+            impl_->pending = pending;
+        } else if (queryString.find('%') != std::string_view::npos)
+        {
+            // Rendering the decoded query would turn an encoded "&"
+            // or "=" back into a delimiter, so only the query is kept
+            // as it was, for GetQueryParameters.  A query without "%"
+            // renders back exactly as it was, so nothing is kept.
+            impl_->encoded.assign(queryString);
+            impl_->encodedRanges[QUERY_ELEMENT] = ComponentRange{0, queryString.length()};
+            impl_->hasEncoded = ElementBit(QUERY_ELEMENT);
+        }
         return true;
     }
-    void Uri::SetScheme(const std::string& scheme) { impl_->scheme = scheme; }
 
-    void Uri::SetUserName(const std::string& name) { impl_->userInfo.name = name; }
+    void Uri::TakeElements(ParsedElements& elements) {
+        impl_->hash.Reset();
+        impl_->hasEncoded = 0;
+        impl_->isRendered = 0;
+        impl_->pending = 0;
+        TakeString(impl_->scheme, elements.scheme);
+        TakeString(impl_->userInfo.name, elements.userName);
+        TakeString(impl_->userInfo.pass, elements.userPass);
+        TakeString(impl_->host, elements.host);
+        impl_->hostKind = elements.hostKind;
+        impl_->hostAddress = elements.hostAddress;
+        impl_->port = elements.port;
+        impl_->hasPort = elements.hasPort;
+        impl_->path = std::move(elements.path);
+        TakeString(impl_->query, elements.query);
+        impl_->hasQuery = elements.hasQuery;
+        TakeString(impl_->fragment, elements.fragment);
+        impl_->hasFragment = elements.hasFragment;
+        if (elements.hasQuery)
+        {
+            TakeString(impl_->encoded, elements.rawQuery);
+            impl_->encodedRanges[QUERY_ELEMENT] = ComponentRange{0, impl_->encoded.length()};
+            impl_->hasEncoded = ElementBit(QUERY_ELEMENT);
+        }
+    }
+
+    void Uri::SetScheme(std::string_view scheme) {
+        impl_->scheme.assign(scheme);
+        impl_->hash.Reset();
+    }
+
+    void Uri::SetScheme(const char* scheme) { SetScheme(std::string_view(scheme)); }
+
+    void Uri::SetScheme(const char* scheme, size_t length) {
+        SetScheme(std::string_view(scheme, length));
+    }
+
+    void Uri::SetScheme(std::pmr::string&& scheme) {
+        TakeString(impl_->scheme, scheme);
+        impl_->hash.Reset();
+    }
+
+    void Uri::SetUserName(std::string_view name) {
+        impl_->Decode(ElementBit(USER_INFO_ELEMENT));
+        impl_->DropEncoded(USER_INFO_ELEMENT);
+        impl_->userInfo.name.assign(name);
+        impl_->hash.Reset();
+    }
+
+    void Uri::SetUserName(const char* name) { SetUserName(std::string_view(name)); }
+
+    void Uri::SetUserName(const char* name, size_t length) {
+        SetUserName(std::string_view(name, length));
+    }
+
+    void Uri::SetUserName(std::pmr::string&& name) {
+        impl_->Decode(ElementBit(USER_INFO_ELEMENT));
+        impl_->DropEncoded(USER_INFO_ELEMENT);
+        TakeString(impl_->userInfo.name, name);
+        impl_->hash.Reset();
+    }
+
+    void Uri::SetUserPass(std::string_view pass) {
+        impl_->Decode(ElementBit(USER_INFO_ELEMENT));
+        impl_->DropEncoded(USER_INFO_ELEMENT);
+        impl_->userInfo.pass.assign(pass);
+        impl_->hash.Reset();
+    }
+
+    void Uri::SetUserPass(const char* pass) { SetUserPass(std::string_view(pass)); }
+
+    void Uri::SetUserPass(const char* pass, size_t length) {
+        SetUserPass(std::string_view(pass, length));
+    }
+
+    void Uri::SetUserPass(std::pmr::string&& pass) {
+        impl_->Decode(ElementBit(USER_INFO_ELEMENT));
+        impl_->DropEncoded(USER_INFO_ELEMENT);
+        TakeString(impl_->userInfo.pass, pass);
+        impl_->hash.Reset();
+    }
+
+    void Uri::SetHost(std::string_view host) {
+        impl_->host.assign(host);
+        impl_->hostKind = ClassifyHost(host, impl_->hostAddress);
+        impl_->hash.Reset();
+    }
+
+    void Uri::SetHost(const char* host) { SetHost(std::string_view(host)); }
+
+    void Uri::SetHost(const char* host, size_t length) { SetHost(std::string_view(host, length)); }
+
+    void Uri::SetHost(std::pmr::string&& host) {
+        TakeString(impl_->host, host);
+        impl_->hostKind = ClassifyHost(impl_->host, impl_->hostAddress);
+        impl_->hash.Reset();
+    }
+
+    bool Uri::SetHost(std::string_view host, HostKind kind) {
+        HostAddress address;
+        switch (kind)
+        {
+        case HostKind::IPv4: {
+            if (!ParseIPv4Address(host, address.ipv4))
+            { return false; }
+            address.family = AddressFamily::IPv4;
+        }
+        break;
+
+        case HostKind::IPv6: {
+            if (!ParseIPv6Address(host, address.ipv6))
+            { return false; }
+            address.family = AddressFamily::IPv6;
+        }
+        break;
 
-    void Uri::SetUserPass(const std::string& pass) { impl_->userInfo.pass = pass; }
+        case HostKind::IPvFuture: {
+            if (!ParseIpLiteral(host, address) || (address.family != AddressFamily::None))
+            { return false; }
+        }
+        break;
 
-    void Uri::SetHost(const std::string& host) { impl_->host = host; }
+        default: {
+            if (ParseIPv4Address(host, address.ipv4))
+            { return false; }
+            address = HostAddress();
+        }
+        break;
+        }
+        impl_->host.assign(host);
+        impl_->hostKind = kind;
+        impl_->hostAddress = address;
+        impl_->hash.Reset();
+        return true;
+    }
 
     void Uri::SetPort(uint16_t port) {
         impl_->port = port;
         if (port > 0)
         { impl_->hasPort = true; }
+        impl_->hash.Reset();
+    }
+
+    void Uri::ClearPort() {
+        impl_->hasPort = false;
+        impl_->hash.Reset();
+    }
+
+    void Uri::SetQuery(std::string_view query) {
+        impl_->DropEncoded(QUERY_ELEMENT);
+        impl_->query.assign(query);
+        impl_->hasQuery = true;
+        impl_->hash.Reset();
     }
 
-    void Uri::ClearPort() { impl_->hasPort = false; }
+    void Uri::SetQuery(const char* query) { SetQuery(std::string_view(query)); }
+
+    void Uri::SetQuery(const char* query, size_t length) {
+        SetQuery(std::string_view(query, length));
+    }
 
-    void Uri::SetQuery(const std::string& query) {
-        impl_->query = query;
+    void Uri::SetQuery(std::pmr::string&& query) {
+        impl_->DropEncoded(QUERY_ELEMENT);
+        TakeString(impl_->query, query);
         impl_->hasQuery = true;
+        impl_->hash.Reset();
+    }
+
+    void Uri::SetFragment(std::string_view fragment) {
+        impl_->DropEncoded(FRAGMENT_ELEMENT);
+        impl_->fragment.assign(fragment);
+        impl_->hasFragment = true;
+        impl_->hash.Reset();
+    }
+
+    void Uri::SetFragment(const char* fragment) { SetFragment(std::string_view(fragment)); }
+
+    void Uri::SetFragment(const char* fragment, size_t length) {
+        SetFragment(std::string_view(fragment, length));
     }
 
-    void Uri::SetFragment(const std::string& fragment) {
-        impl_->fragment = fragment;
+    void Uri::SetFragment(std::pmr::string&& fragment) {
+        impl_->DropEncoded(FRAGMENT_ELEMENT);
+        TakeString(impl_->fragment, fragment);
         impl_->hasFragment = true;
+        impl_->hash.Reset();
+    }
+
+    void Uri::SetPath(const std::vector<std::string>& path) {
+        impl_->DropEncoded(PATH_ELEMENT);
+        impl_->path.Assign(path);
+        impl_->hash.Reset();
+    }
+
+    void Uri::AppendPathSegment(std::string_view segment) {
+        impl_->EditPath().AppendSegment(segment);
+    }
+
+    void Uri::PopPathSegment() {
+        auto& path = impl_->EditPath();
+        if (!path.IsEmpty())
+        { path.PopSegment(); }
     }
 
-    void Uri::SetPath(const std::vector<std::string>& path) { impl_->path = path; }
+    bool Uri::ReplacePathSegment(size_t index, std::string_view segment) {
+        impl_->Decode(ElementBit(PATH_ELEMENT));
+        if (index >= impl_->path.GetSegmentCount())
+        { return false; }
+        impl_->EditPath().ReplaceSegment(index, segment);
+        return true;
+    }
+
+    void Uri::TruncatePath(size_t count) { impl_->EditPath().Truncate(count); }
 
     std::string Uri::GenerateString() const {
-        std::ostringstream buffer;
-        if (!impl_->scheme.empty())
-        { buffer << impl_->scheme << ':'; }
-        if (!impl_->host.empty())
-        {
-            buffer << "//";
-            if (!impl_->userInfo.name.empty())
-            {
-                buffer << impl_->EncodeElement(impl_->userInfo.name, USER_INFO_CHAR);
-                if (!impl_->userInfo.pass.empty())
-                { buffer << ':' << impl_->userInfo.pass; }
-                buffer << '@';
-            }
-            if (ValidateIPv6Address(impl_->host))
-            {
-                buffer << '[' << StringUtils::NormalizeCaseInsensitiveString(impl_->host) << ']';
-            } else
-            { buffer << impl_->EncodeElement(impl_->host, REG_NAME_NOT_PCT_ENCODED); }
-            if (impl_->hasPort && (impl_->port > 0))
-            { buffer << ':' << impl_->port; }
-        }
-        if (impl_->IsPathAbsolute() && (impl_->path.size() == 1))
-        { buffer << '/'; }
-        size_t i = 0;
-        for (const auto& segment : impl_->path)
+        std::string buffer;
+        AppendTo(buffer);
+        return buffer;
+    }
+
+    void Uri::AppendTo(std::string& buffer) const {
+        impl_->Decode(ALL_ENCODED_ELEMENTS);
+        LengthCounter counter;
+        impl_->Generate(counter);
+        const auto start = buffer.length();
+        buffer.resize(start + counter.GetLength());
+        BufferWriter writer(&buffer[start]);
+        impl_->Generate(writer);
+    }
+
+    size_t Uri::WriteTo(char* buffer, size_t bufferSize) const {
+        impl_->Decode(ALL_ENCODED_ELEMENTS);
+        LengthCounter counter;
+        impl_->Generate(counter);
+        if (counter.GetLength() <= bufferSize)
         {
-            buffer << impl_->EncodeElement(segment, PCHAR_NOT_PCT_ENCODED);
-            if (i + 1 < impl_->path.size())
-            { buffer << '/'; }
-            ++i;
+            BufferWriter writer(buffer);
+            impl_->Generate(writer);
         }
+        return counter.GetLength();
+    }
 
-        if (impl_->hasQuery)
-        { buffer << '?' << impl_->EncodeElement(impl_->query, QUERY_OR_FRAGMENT_CHAR); }
-        if (impl_->hasFragment)
-        { buffer << '#' << impl_->EncodeElement(impl_->fragment, QUERY_OR_FRAGMENT_CHAR); }
+    std::string Uri::GetScheme() const { return std::string(impl_->scheme); }
 
-        return buffer.str();
-    }
+    std::string_view Uri::GetSchemeView() const { return impl_->scheme; }
 
-    std::string Uri::GetScheme() const { return impl_->scheme; }
+    std::string Uri::GetHost() const { return std::string(impl_->host); }
 
-    std::string Uri::GetHost() const { return impl_->host; }
+    std::string_view Uri::GetHostView() const { return impl_->host; }
 
-    std::vector<std::string> Uri::GetPath() const { return impl_->path; }
+    HostAddress Uri::GetHostAddress() const { return impl_->hostAddress; }
+
+    HostKind Uri::GetHostKind() const { return impl_->hostKind; }
+
+    std::vector<std::string> Uri::GetPath() const {
+        impl_->Decode(ElementBit(PATH_ELEMENT));
+        return impl_->path.ToVector();
+    }
+
+    PathSegments Uri::GetPathSegments() const {
+        impl_->Decode(ElementBit(PATH_ELEMENT));
+        return impl_->path.GetSegments();
+    }
+
+    std::string_view Uri::GetRawPath() const { return impl_->GetEncoded(PATH_ELEMENT); }
 
     bool Uri::HasPort() const { return impl_->hasPort; }
 
@@ -1078,125 +1334,195 @@ namespace Uri
     bool Uri::IsRelativeReference() const { return impl_->scheme.empty(); }
 
     bool Uri::HasRelativePath() const {
-        if (impl_->path.empty())
+        impl_->Decode(ElementBit(PATH_ELEMENT));
+        if (impl_->path.IsEmpty())
         {
             return true;
         } else
-        { return !impl_->path[0].empty(); }
+        { return !impl_->path.GetFirstSegment().empty(); }
+    }
+
+    std::string Uri::GetQuery() const { return std::string(GetQueryView()); }
+
+    std::string_view Uri::GetQueryView() const {
+        impl_->Decode(ElementBit(QUERY_ELEMENT));
+        return impl_->query;
     }
 
-    std::string Uri::GetQuery() const { return impl_->query; }
+    std::string_view Uri::GetRawQuery() const { return impl_->GetEncoded(QUERY_ELEMENT); }
+
+    QueryParameters Uri::GetQueryParameters() const { return QueryParameters(GetRawQuery()); }
 
     bool Uri::HasQuery() const { return impl_->hasQuery; }
 
-    void Uri::ClearQuery() { impl_->hasQuery = false; }
+    void Uri::ClearQuery() {
+        impl_->DropEncoded(QUERY_ELEMENT);
+        impl_->query.clear();
+        impl_->hasQuery = false;
+        impl_->hash.Reset();
+    }
 
     bool Uri::HasFragment() const { return impl_->hasFragment; }
 
-    void Uri::ClearFragment() { impl_->hasFragment = false; }
+    void Uri::ClearFragment() {
+        impl_->DropEncoded(FRAGMENT_ELEMENT);
+        impl_->fragment.clear();
+        impl_->hasFragment = false;
+        impl_->hash.Reset();
+    }
+
+    std::string Uri::GetFragment() const { return std::string(GetFragmentView()); }
+
+    std::string_view Uri::GetFragmentView() const {
+        impl_->Decode(ElementBit(FRAGMENT_ELEMENT));
+        return impl_->fragment;
+    }
+
+    std::string_view Uri::GetRawFragment() const { return impl_->GetEncoded(FRAGMENT_ELEMENT); }
 
-    std::string Uri::GetFragment() const { return impl_->fragment; }
+    UserInfo Uri::GetUserInfo() const {
+        impl_->Decode(ElementBit(USER_INFO_ELEMENT));
+        UserInfo userInfo;
+        userInfo.name.assign(impl_->userInfo.name);
+        userInfo.pass.assign(impl_->userInfo.pass);
+        return userInfo;
+    }
+
+    std::string_view Uri::GetUserNameView() const {
+        impl_->Decode(ElementBit(USER_INFO_ELEMENT));
+        return impl_->userInfo.name;
+    }
 
-    UserInfo Uri::GetUserInfo() const { return impl_->userInfo; }
+    std::string_view Uri::GetUserPassView() const {
+        impl_->Decode(ElementBit(USER_INFO_ELEMENT));
+        return impl_->userInfo.pass;
+    }
+
+    std::string_view Uri::GetRawUserInfo() const { return impl_->GetEncoded(USER_INFO_ELEMENT); }
 
     void Uri::NormalizePath() {
-        // Rebuild the path one segment
-        // at a time, removing and applying special
-        // navigation segments ("." and "..") as we go.
-        auto oldPath = std::move(impl_->path);
-        impl_->path.clear();
-        bool atDirectoryLevel = false;
-        for (const auto segment : oldPath)
+        impl_->Decode(ElementBit(PATH_ELEMENT));
+        if (impl_->path.RemoveDotSegments())
         {
-            if (segment == ".")
-            {
-                atDirectoryLevel = true;
-            } else if (segment == "..")
-            {
-                // Remove last path element
-                // if we can navigate up a level.
-                if (!impl_->path.empty())
-                {
-                    if (impl_->CanNavigatePathUpOneLevel())
-                    { impl_->path.pop_back(); }
-                }
-                atDirectoryLevel = true;
-            } else
-            {
-                // Non-relative elements can just
-                // transfer over fine.  An empty
-                // segment marks a transition to
-                // a directory level context.  If we're
-                // already in that context, we
-                // want to ignore the transition.
-                if (!atDirectoryLevel || !segment.empty())
-                { impl_->path.push_back(segment); }
-                atDirectoryLevel = segment.empty();
-            }
+            impl_->DropEncoded(PATH_ELEMENT);
+            impl_->hash.Reset();
         }
+    }
 
-        // If at the end of rebuilding the path,
-        // we're in a directory level context,
-        // add an empty segment to mark the fact.
-        if (atDirectoryLevel && (!impl_->path.empty() && !impl_->path.back().empty()))
-        { impl_->path.push_back(""); }
+    void Uri::Normalize() {
+        LowerCaseInPlace(impl_->scheme);
+        LowerCaseInPlace(impl_->host);
+        if (impl_->hasPort && (impl_->port == GetDefaultPort(impl_->scheme)))
+        { impl_->hasPort = false; }
+        for (size_t i = 0; i < ENCODED_ELEMENT_COUNT; ++i)
+        { impl_->NormalizeEncoded((EncodedElement)i); }
+
+        // A path still waiting to be decoded is left so
+        // unless it has segments to remove.
+        if (((impl_->pending & ElementBit(PATH_ELEMENT)) == 0) ||
+            NeedsDotSegmentRemoval(impl_->GetEncoded(PATH_ELEMENT)))
+        { NormalizePath(); }
+        impl_->hash.Reset();
     }
+
     Uri Uri::Resolve(const Uri& relativeReference) const {
+        Uri target;
+        ResolveInto(relativeReference, target, nullptr);
+        return target;
+    }
+
+    void Uri::ResolveInto(const Uri& relativeReference, Uri& target) const {
+        if ((&target == this) || (&target == &relativeReference))
+        {
+            // Resolve into a URI from the memory resource of the
+            // target, so that the target keeps its resource.
+            Uri resolved(target.GetMemoryResource());
+            ResolveInto(relativeReference, resolved, nullptr);
+            target = std::move(resolved);
+            return;
+        }
+        ResolveInto(relativeReference, target, nullptr);
+    }
+
+    void Uri::ResolveInto(const Uri& relativeReference, Uri& target,
+                          const PathStorage* mergePrefix) const {
         //  Resole the reference according to the algorithm
         //  from section 5.2.2 in
         //  RFC 3986
-        Uri target;
+        impl_->Decode(ALL_ENCODED_ELEMENTS);
+        relativeReference.impl_->Decode(ALL_ENCODED_ELEMENTS);
+        target.impl_->hasEncoded = 0;
+        target.impl_->isRendered = 0;
+        target.impl_->pending = 0;
+        target.impl_->hash.Reset();
         if (!relativeReference.impl_->scheme.empty())
         {
             target.impl_->scheme = relativeReference.impl_->scheme;
             target.impl_->host = relativeReference.impl_->host;
+            target.impl_->hostKind = relativeReference.impl_->hostKind;
+            target.impl_->hostAddress = relativeReference.impl_->hostAddress;
             target.impl_->path = relativeReference.impl_->path;
             target.impl_->hasPort = relativeReference.impl_->hasPort;
             target.impl_->port = relativeReference.impl_->port;
             target.impl_->userInfo = relativeReference.impl_->userInfo;
-            target.NormalizePath();
+            (void)target.impl_->path.RemoveDotSegments();
             target.impl_->query = relativeReference.impl_->query;
+            target.impl_->hasQuery = relativeReference.impl_->hasQuery;
         } else
         {
             if (!relativeReference.impl_->host.empty())
             {
                 target.impl_->host = relativeReference.impl_->host;
+                target.impl_->hostKind = relativeReference.impl_->hostKind;
+                target.impl_->hostAddress = relativeReference.impl_->hostAddress;
                 target.impl_->path = relativeReference.impl_->path;
                 target.impl_->hasPort = relativeReference.impl_->hasPort;
                 target.impl_->port = relativeReference.impl_->port;
                 target.impl_->userInfo = relativeReference.impl_->userInfo;
-                target.NormalizePath();
+                (void)target.impl_->path.RemoveDotSegments();
                 target.impl_->query = relativeReference.impl_->query;
+                target.impl_->hasQuery = relativeReference.impl_->hasQuery;
             } else
             {
-                if (relativeReference.impl_->path.empty())
+                if (relativeReference.impl_->path.IsEmpty())
                 {
                     target.impl_->path = impl_->path;
-                    if (!relativeReference.impl_->query.empty())
+                    if (relativeReference.impl_->hasQuery)
                     {
                         target.impl_->query = relativeReference.impl_->query;
+                        target.impl_->hasQuery = true;
                     } else
-                    { target.impl_->query = impl_->query; }
+                    {
+                        target.impl_->query = impl_->query;
+                        target.impl_->hasQuery = impl_->hasQuery;
+                    }
                 } else
                 {
-                    if (!relativeReference.impl_->path.empty() &&
-                        (relativeReference.impl_->path[0] == ""))
+                    if (relativeReference.impl_->IsPathAbsolute())
                     {
                         target.impl_->path = relativeReference.impl_->path;
-                        target.NormalizePath();
+                        (void)target.impl_->path.RemoveDotSegments();
                     } else
                     {
-                        target.impl_->path = impl_->path;
-                        if (target.impl_->path.size() > 1)
-                        { target.impl_->path.pop_back(); }
-                        std::copy(relativeReference.impl_->path.begin(),
-                                  relativeReference.impl_->path.end(),
-                                  std::back_inserter(target.impl_->path));
-                        target.NormalizePath();
+                        if (mergePrefix != nullptr)
+                        {
+                            target.impl_->path = *mergePrefix;
+                        } else
+                        {
+                            target.impl_->path = impl_->path;
+                            if (target.impl_->path.GetSegmentCount() > 1)
+                            { target.impl_->path.PopSegment(); }
+                        }
+                        for (const auto segment : relativeReference.impl_->path.GetSegments())
+                        { target.impl_->path.AppendSegment(segment); }
+                        (void)target.impl_->path.RemoveDotSegments();
                     }
                     target.impl_->query = relativeReference.impl_->query;
+                    target.impl_->hasQuery = relativeReference.impl_->hasQuery;
                 }
                 target.impl_->host = impl_->host;
+                target.impl_->hostKind = impl_->hostKind;
+                target.impl_->hostAddress = impl_->hostAddress;
                 target.impl_->userInfo = impl_->userInfo;
                 target.impl_->hasPort = impl_->hasPort;
                 target.impl_->port = impl_->port;
@@ -1204,6 +1530,106 @@ namespace Uri
             target.impl_->scheme = impl_->scheme;
         }
         target.impl_->fragment = relativeReference.impl_->fragment;
-        return target;
+        target.impl_->hasFragment = relativeReference.impl_->hasFragment;
+    }
+
+    bool Uri::ResolveString(std::string_view base, std::string_view relativeReference,
+                            std::string& target) {
+        ComponentLayout baseLayout;
+        ComponentLayout referenceLayout;
+        if (!LocateComponents(base, baseLayout) || !baseLayout.hasScheme ||
+            !LocateComponents(relativeReference, referenceLayout))
+        { return false; }
+
+        // Pick where each element of the target comes from,
+        // following section 5.2.2 of RFC 3986.
+        const auto& authoritySource = (referenceLayout.hasScheme || referenceLayout.hasAuthority)
+                                          ? referenceLayout
+                                          : baseLayout;
+        const auto authorityString = (&authoritySource == &baseLayout) ? base : relativeReference;
+        const auto basePath = Slice(base, baseLayout.path);
+        const auto referencePath = Slice(relativeReference, referenceLayout.path);
+        const bool fromReference = (&authoritySource == &referenceLayout);
+        std::string_view query;
+        bool hasQuery = referenceLayout.hasQuery;
+        if (hasQuery || fromReference || !referencePath.empty())
+        {
+            query = Slice(relativeReference, referenceLayout.query);
+        } else
+        {
+            query = Slice(base, baseLayout.query);
+            hasQuery = baseLayout.hasQuery;
+        }
+
+        // Recompose the target following section 5.3, putting the path
+        // at the end of the string so that its dot segments can be
+        // removed in place.
+        target.clear();
+        target.append(referenceLayout.hasScheme ? Slice(relativeReference, referenceLayout.scheme)
+                                                : Slice(base, baseLayout.scheme));
+        target.push_back(':');
+        if (authoritySource.hasAuthority)
+        {
+            const auto authorityStart =
+                (authoritySource.hasScheme ? (authoritySource.scheme.length + 1) : 0) + 2;
+            target.append("//");
+            target.append(authorityString.substr(authorityStart,
+                                                 authoritySource.path.offset - authorityStart));
+        }
+        const auto pathStart = target.length();
+        if (fromReference || (!referencePath.empty() && (referencePath[0] == '/')))
+        {
+            target.append(referencePath);
+        } else if (referencePath.empty())
+        {
+            target.append(basePath);
+        } else
+        {
+            // Merge the paths: everything in the base path up to its last
+            // "/", or just "/" if the base has an authority and no path.
+            if (baseLayout.hasAuthority && basePath.empty())
+            {
+                target.push_back('/');
+            } else
+            {
+                const auto lastSlash = basePath.rfind('/');
+                if (lastSlash != std::string_view::npos)
+                { target.append(basePath.substr(0, lastSlash + 1)); }
+            }
+            target.append(referencePath);
+        }
+        if (!referencePath.empty() || fromReference)
+        { RemoveDotSegmentsInPlace(target, pathStart); }
+        if (hasQuery)
+        {
+            target.push_back('?');
+            target.append(query);
+        }
+        if (referenceLayout.hasFragment)
+        {
+            target.push_back('#');
+            target.append(Slice(relativeReference, referenceLayout.fragment));
+        }
+        return true;
+    }
+
+    size_t UriHash::operator()(const Uri& uri) const { return uri.GetHash(); }
+
+    size_t UriHash::operator()(std::string_view uriString) const {
+        const auto uri = ParseScratchUri(uriString);
+        if (uri == nullptr)
+        { return 0; }
+        return uri->GetHash();
+    }
+
+    bool UriEqual::operator()(const Uri& lhs, const Uri& rhs) const { return lhs == rhs; }
+
+    bool UriEqual::operator()(const Uri& lhs, std::string_view rhs) const {
+        const auto uri = ParseScratchUri(rhs);
+        return (uri != nullptr) && (lhs == *uri);
+    }
+
+    bool UriEqual::operator()(std::string_view lhs, const Uri& rhs) const {
+        return (*this)(rhs, lhs);
     }
-}  // namespace Uri
\ No newline at end of file
+}  // namespace Uri
@@ -0,0 +1,476 @@
+/**
+ * @file UriComponents.cpp
+ *
+ * This module contains the implementation of the functions used by
+ * Uri::Uri and Uri::UriView to locate, validate and decode the
+ * elements of a URI string.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "UriComponents.hpp"
+#include "PercentEncodedCharacterDecoder.hpp"
+#include "SpanScanner.hpp"
+#include <string.h>
+
+namespace
+{
+    /**
+     * This is the set of characters which may appear in the authority
+     * without ending it, used to skip quickly to its end.
+     */
+    constexpr Uri::CharacterSet AUTHORITY_NOT_DELIMITER{Uri::USER_INFO_CHAR, '@', '[', ']', '%'};
+
+    /**
+     * This is the set of characters which may appear in the path
+     * without ending it, used to skip quickly to its end.
+     */
+    constexpr Uri::CharacterSet PATH_NOT_DELIMITER{Uri::PCHAR_NOT_PCT_ENCODED, '/', '%'};
+
+    /**
+     * This is the set of characters which may appear in the query
+     * without ending it, used to skip quickly to its end.
+     */
+    constexpr Uri::CharacterSet QUERY_NOT_DELIMITER{Uri::QUERY_OR_FRAGMENT_CHAR, '%'};
+
+    /**
+     * This function finds the first of the given delimiters in the
+     * given string, at or after the given position.  The run of
+     * characters which are usual in the element being scanned is
+     * skipped with the span scanner first.
+     *
+     * @param[in] uriString
+     *      This is the string to search.
+     * @param[in] position
+     *      This is where to start the search.
+     * @param[in] usualCharacters
+     *      This is the set of characters which are known not to
+     *      be delimiters.
+     * @param[in] delimiters
+     *      These are the delimiters to look for.
+     * @return
+     *      The position of the first delimiter is returned.
+     * @retval std::string_view::npos
+     *      This is returned if none of the delimiters is found.
+     */
+    size_t FindDelimiter(std::string_view uriString, size_t position,
+                         const Uri::CharacterSet& usualCharacters, const char* delimiters) {
+        position += Uri::FindFirstNotInSet(usualCharacters, uriString.data() + position,
+                                           uriString.length() - position);
+        return uriString.find_first_of(delimiters, position);
+    }
+}  // namespace
+
+namespace Uri
+{
+    bool LocateAuthority(std::string_view uriString, size_t authorityStart, size_t authorityEnd,
+                         ComponentLayout& layout) {
+        auto hostStart = authorityStart;
+        const auto userInfoEnd = uriString.find('@', authorityStart);
+        if ((userInfoEnd != std::string_view::npos) && (userInfoEnd < authorityEnd))
+        {
+            layout.hasUserInfo = true;
+            layout.userInfo = {authorityStart, userInfoEnd - authorityStart};
+            hostStart = userInfoEnd + 1;
+        }
+        size_t hostEnd;
+        if ((hostStart < authorityEnd) && (uriString[hostStart] == '['))
+        {
+            const auto literalEnd = uriString.find(']', hostStart);
+            if ((literalEnd == std::string_view::npos) || (literalEnd >= authorityEnd))
+            { return false; }
+            layout.hostIsIpLiteral = true;
+            layout.host = {hostStart + 1, literalEnd - hostStart - 1};
+            hostEnd = literalEnd + 1;
+            if ((hostEnd < authorityEnd) && (uriString[hostEnd] != ':'))
+            { return false; }
+        } else
+        {
+            hostEnd = uriString.find(':', hostStart);
+            if ((hostEnd == std::string_view::npos) || (hostEnd > authorityEnd))
+            { hostEnd = authorityEnd; }
+            layout.host = {hostStart, hostEnd - hostStart};
+        }
+        if (hostEnd < authorityEnd)
+        { layout.port = {hostEnd + 1, authorityEnd - hostEnd - 1}; }
+        return true;
+    }
+
+    bool LocateComponents(std::string_view uriString, ComponentLayout& layout,
+                          ComponentMask components) {
+        layout = ComponentLayout();
+        const auto length = uriString.length();
+        size_t position = 0;
+
+        // scheme: a colon appearing before any "/", "?" or "#"
+        const auto firstDelimiter = uriString.find_first_of(":/?#");
+        if ((firstDelimiter != std::string_view::npos) && (uriString[firstDelimiter] == ':'))
+        {
+            layout.hasScheme = true;
+            layout.scheme = {0, firstDelimiter};
+            position = firstDelimiter + 1;
+        }
+        if (!HasAnyOf(components, ComponentMask::Authority | ComponentMask::Path |
+                                      ComponentMask::Query | ComponentMask::Fragment))
+        { return true; }
+
+        // authority
+        if ((length - position >= 2) && (uriString[position] == '/') &&
+            (uriString[position + 1] == '/'))
+        {
+            layout.hasAuthority = true;
+            const auto authorityStart = position + 2;
+            auto authorityEnd =
+                FindDelimiter(uriString, authorityStart, AUTHORITY_NOT_DELIMITER, "/?#");
+            if (authorityEnd == std::string_view::npos)
+            { authorityEnd = length; }
+            if (!LocateAuthority(uriString, authorityStart, authorityEnd, layout))
+            { return false; }
+            position = authorityEnd;
+        }
+        if (!HasAnyOf(components, ComponentMask::Path | ComponentMask::Query |
+                                      ComponentMask::Fragment))
+        { return true; }
+
+        // path
+        auto pathEnd = FindDelimiter(uriString, position, PATH_NOT_DELIMITER, "?#");
+        if (pathEnd == std::string_view::npos)
+        { pathEnd = length; }
+        layout.path = {position, pathEnd - position};
+        position = pathEnd;
+        if (!HasAnyOf(components, ComponentMask::Query | ComponentMask::Fragment))
+        { return true; }
+
+        // query
+        if ((position < length) && (uriString[position] == '?'))
+        {
+            auto queryEnd = FindDelimiter(uriString, position + 1, QUERY_NOT_DELIMITER, "#");
+            if (queryEnd == std::string_view::npos)
+            { queryEnd = length; }
+            layout.hasQuery = true;
+            layout.query = {position + 1, queryEnd - position - 1};
+            position = queryEnd;
+        }
+
+        // fragment
+        if (position < length)
+        {
+            layout.hasFragment = true;
+            layout.fragment = {position + 1, length - position - 1};
+        }
+        return true;
+    }
+
+    bool ParseUint16(std::string_view numberString, uint16_t& number) {
+        uint32_t number32Bits = 0;
+        for (auto c : numberString)
+        {
+            if ((c < '0') || (c > '9'))
+            { return false; }
+            number32Bits *= 10;
+            number32Bits += (uint16_t)(c - '0');
+            if ((number32Bits & ~((1 << 16) - 1)) != 0)
+            { return false; }
+        }
+        number = (uint16_t)number32Bits;
+        return true;
+    }
+
+    bool ParseIPv4Address(std::string_view address, uint32_t& value) {
+        // IPv4address = dec-octet "." dec-octet "." dec-octet "." dec-octet
+        uint32_t result = 0;
+        size_t numOctets = 0;
+        size_t position = 0;
+        while (numOctets < 4)
+        {
+            if ((numOctets > 0) && ((position >= address.length()) || (address[position++] != '.')))
+            { return false; }
+            const auto octetStart = position;
+            uint32_t octet = 0;
+            while ((position < address.length()) && (address[position] >= '0') &&
+                   (address[position] <= '9'))
+            {
+                octet = octet * 10 + (uint32_t)(address[position++] - '0');
+                if ((octet > 255) || (position - octetStart > 3))
+                { return false; }
+            }
+            const auto numDigits = position - octetStart;
+            if ((numDigits == 0) || ((numDigits > 1) && (address[octetStart] == '0')))
+            { return false; }
+            result = (result << 8) | octet;
+            ++numOctets;
+        }
+        if (position != address.length())
+        { return false; }
+        value = result;
+        return true;
+    }
+
+    bool ParseIPv6Address(std::string_view address, uint8_t (&bytes)[16]) {
+        uint16_t groups[8];
+        size_t numGroups = 0;
+        size_t doubleColonAt = SIZE_MAX;
+        size_t position = 0;
+        if ((address.length() >= 2) && (address[0] == ':') && (address[1] == ':'))
+        {
+            doubleColonAt = 0;
+            position = 2;
+        }
+        while (position < address.length())
+        {
+            // A group of up to four hex digits, or the IPv4 address
+            // making up the last two groups.
+            const auto groupStart = position;
+            uint32_t group = 0;
+            int8_t digit;
+            while ((position < address.length()) &&
+                   ((digit = HEX_DIGIT_VALUES.values[(uint8_t)address[position]]) >= 0))
+            {
+                if (position - groupStart == 4)
+                { return false; }
+                group = (group << 4) | (uint32_t)digit;
+                ++position;
+            }
+            if ((position < address.length()) && (address[position] == '.'))
+            {
+                uint32_t ipv4Address;
+                if ((numGroups > 6) ||
+                    !ParseIPv4Address(address.substr(groupStart), ipv4Address))
+                { return false; }
+                groups[numGroups++] = (uint16_t)(ipv4Address >> 16);
+                groups[numGroups++] = (uint16_t)ipv4Address;
+                position = address.length();
+                break;
+            }
+            if ((position == groupStart) || (numGroups == 8))
+            { return false; }
+            groups[numGroups++] = (uint16_t)group;
+            if (position == address.length())
+            { break; }
+            if ((address[position++] != ':') || (position == address.length()))
+            { return false; }
+            if (address[position] == ':')
+            {
+                if (doubleColonAt != SIZE_MAX)
+                { return false; }
+                doubleColonAt = numGroups;
+                ++position;
+            }
+        }
+        if (doubleColonAt == SIZE_MAX)
+        {
+            if (numGroups != 8)
+            { return false; }
+        } else if (numGroups > 7)
+        { return false; }
+
+        // A double colon stands for as many zero groups as are missing.
+        const auto numZeroGroups = 8 - numGroups;
+        size_t byte = 0;
+        for (size_t i = 0; i < numGroups; ++i)
+        {
+            if (i == doubleColonAt)
+            {
+                memset(bytes + byte, 0, numZeroGroups * 2);
+                byte += numZeroGroups * 2;
+            }
+            bytes[byte++] = (uint8_t)(groups[i] >> 8);
+            bytes[byte++] = (uint8_t)groups[i];
+        }
+        if (doubleColonAt == numGroups)
+        { memset(bytes + byte, 0, numZeroGroups * 2); }
+        return true;
+    }
+
+    bool ParseIpLiteral(std::string_view literal, HostAddress& address) {
+        address = HostAddress();
+        if (literal.empty() || (literal[0] != 'v'))
+        {
+            if (!ParseIPv6Address(literal, address.ipv6))
+            { return false; }
+            address.family = AddressFamily::IPv6;
+            return true;
+        }
+        // IPvFuture: "v" 1*HEXDIG "." 1*( unreserved / sub-delims / ":" )
+        const auto dot = literal.find('.');
+        if ((dot == std::string_view::npos) || (dot < 2) || (dot + 1 == literal.length()))
+        { return false; }
+        for (size_t i = 1; i < dot; ++i)
+        {
+            if (!HEXDIGIT.Contains(literal[i]))
+            { return false; }
+        }
+        for (size_t i = dot + 1; i < literal.length(); ++i)
+        {
+            if (!IPV_LAST_PART_FUTURE.Contains(literal[i]))
+            { return false; }
+        }
+        return true;
+    }
+
+    bool ValidateIpLiteral(std::string_view literal) {
+        HostAddress address;
+        return ParseIpLiteral(literal, address);
+    }
+
+    HostKind ClassifyHost(std::string_view host, HostAddress& address) {
+        address = HostAddress();
+        if (ParseIPv4Address(host, address.ipv4))
+        {
+            address.family = AddressFamily::IPv4;
+            return HostKind::IPv4;
+        }
+        if (host.find(':') == std::string_view::npos)
+        { return HostKind::RegName; }
+        if (!ParseIpLiteral(host, address))
+        { return HostKind::RegName; }
+        return (address.family == AddressFamily::IPv6) ? HostKind::IPv6 : HostKind::IPvFuture;
+    }
+
+    std::string_view FormatIPv6Address(const uint8_t (&bytes)[16], char (&text)[IPV6_TEXT_SIZE]) {
+        uint16_t groups[8];
+        for (size_t i = 0; i < 8; ++i)
+        { groups[i] = (uint16_t)((bytes[i * 2] << 8) | bytes[i * 2 + 1]); }
+
+        // The last 32 bits are written as an IPv4 address for the
+        // IPv4-mapped (::ffff:0:0/96), IPv4-translated (::ffff:0:0:0/96)
+        // and well-known (64:ff9b::/96) prefixes, as RFC 5952 section 5
+        // recommends.
+        const bool mixed =
+            ((groups[0] == 0) && (groups[1] == 0) && (groups[2] == 0) && (groups[3] == 0) &&
+             (((groups[4] == 0) && (groups[5] == 0xFFFF)) ||
+              ((groups[4] == 0xFFFF) && (groups[5] == 0)))) ||
+            ((groups[0] == 0x64) && (groups[1] == 0xFF9B) && (groups[2] == 0) &&
+             (groups[3] == 0) && (groups[4] == 0) && (groups[5] == 0));
+        const size_t numHexGroups = mixed ? 6 : 8;
+
+        // The longest run of two or more zero groups, the first
+        // of them if there is a tie, is written as "::".
+        size_t runStart = SIZE_MAX;
+        size_t runLength = 1;
+        for (size_t i = 0; i < numHexGroups;)
+        {
+            if (groups[i] != 0)
+            {
+                ++i;
+                continue;
+            }
+            const auto start = i;
+            while ((i < numHexGroups) && (groups[i] == 0))
+            { ++i; }
+            if (i - start > runLength)
+            {
+                runStart = start;
+                runLength = i - start;
+            }
+        }
+
+        size_t length = 0;
+        for (size_t i = 0; i < numHexGroups; ++i)
+        {
+            if (i == runStart)
+            {
+                text[length++] = ':';
+                if (i == 0)
+                { text[length++] = ':'; }
+                i += runLength - 1;
+                continue;
+            }
+            bool leading = true;
+            for (int shift = 12; shift >= 0; shift -= 4)
+            {
+                const auto digit = (groups[i] >> shift) & 0x0F;
+                if (leading && (digit == 0) && (shift > 0))
+                { continue; }
+                leading = false;
+
+                // RFC 5952 asks for lower case, which setting bit 5
+                // gives for letters and leaves digits as they are.
+                text[length++] = (char)(HEX_DIGITS[digit] | 0x20);
+            }
+            if ((i + 1 < numHexGroups) || mixed)
+            { text[length++] = ':'; }
+        }
+        if (mixed)
+        {
+            for (size_t i = 12; i < 16; ++i)
+            {
+                char digits[3];
+                size_t first = sizeof(digits);
+                auto octet = bytes[i];
+                do
+                {
+                    digits[--first] = (char)('0' + octet % 10);
+                    octet /= 10;
+                } while (octet != 0);
+                memcpy(text + length, digits + first, sizeof(digits) - first);
+                length += sizeof(digits) - first;
+                if (i < 15)
+                { text[length++] = '.'; }
+            }
+        }
+        return std::string_view(text, length);
+    }
+
+    bool ValidateScheme(std::string_view scheme) {
+        if (scheme.empty() || !ALPHA.Contains(scheme[0]))
+        { return false; }
+        for (size_t i = 1; i < scheme.length(); ++i)
+        {
+            if (!SCHEME_NOT_FIRST.Contains(scheme[i]))
+            { return false; }
+        }
+        return true;
+    }
+
+    bool ValidateElement(std::string_view element, const CharacterSet& allowedCharacters) {
+        size_t position = 0;
+        for (;;)
+        {
+            position += FindFirstNotInSet(allowedCharacters, element.data() + position,
+                                          element.length() - position);
+            if (position == element.length())
+            { return true; }
+            if ((element[position] != '%') || (element.length() - position < 3) ||
+                !HEXDIGIT.Contains(element[position + 1]) ||
+                !HEXDIGIT.Contains(element[position + 2]))
+            { return false; }
+            position += 3;
+        }
+    }
+
+    bool DecodeElement(std::string_view element, const CharacterSet& allowedCharacters,
+                       std::pmr::string& decodedElement) {
+        decodedElement.clear();
+        return AppendDecodedElement(element, allowedCharacters, decodedElement);
+    }
+
+    bool AppendDecodedElement(std::string_view element, const CharacterSet& allowedCharacters,
+                              std::pmr::string& output) {
+        if (element.empty())
+        { return true; }
+
+        // Decoding never makes an element longer, so the output is
+        // grown once and written through a pointer.
+        const auto start = output.length();
+        output.resize(start + element.length());
+        DecodingOptions options;
+        options.allowedCharacters = &allowedCharacters;
+        const auto written = PercentEncodedCharacterDecoder::Decode(element, &output[start], options);
+        if (written == std::string_view::npos)
+        {
+            output.resize(start);
+            return false;
+        }
+        output.resize(start + written);
+        return true;
+    }
+
+    void LowerCaseInPlace(std::pmr::string& element) {
+        for (auto& c : element)
+        {
+            if ((c >= 'A') && (c <= 'Z'))
+            { c = (char)(c - 'A' + 'a'); }
+        }
+    }
+}  // namespace Uri
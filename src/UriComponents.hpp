@@ -0,0 +1,405 @@
+#ifndef URI_URI_COMPONENTS_HPP
+#define URI_URI_COMPONENTS_HPP
+
+/**
+ * @file UriComponents.hpp
+ *
+ * This module declares the character sets and functions used by
+ * Uri::Uri and Uri::UriView to locate, validate and decode the
+ * elements of a URI string.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "CharacterSet.hpp"
+#include <Uri/Uri.hpp>
+#include <memory_resource>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <string_view>
+
+namespace Uri
+{
+    /**
+     * This is the character set containing the alphabetic characters
+     * from the ASCII characters.
+     */
+    inline constexpr CharacterSet ALPHA{CharacterSet('a', 'z'), CharacterSet('A', 'Z')};
+
+    /**
+     * This is the character set containing the numerical characters
+     * from the ASCII set.
+     */
+    inline constexpr CharacterSet DIGIT('0', '9');
+
+    /**
+     * This is the character set containing the hexadecimal digits.
+     */
+    inline constexpr CharacterSet HEXDIGIT{CharacterSet('0', '9'), CharacterSet('A', 'F'),
+                                         CharacterSet('a', 'f')};
+
+    /**
+     * This is the character st corresponds to the "unreserved" syntax
+     * specified in RFC 3986
+     */
+    inline constexpr CharacterSet UNRESERVED{ALPHA, DIGIT, '.', '-', '_', '~'};
+
+    /**
+     * This is the character st corresponds to the "sub-delims" syntax
+     * specified in RFC 3986
+     */
+    inline constexpr CharacterSet SUB_DELIMS{'!', '$', '&', '\'', '(', ')', '*',
+                                           '+', ',', ';', '='};
+
+    /**
+     * This is the character st corresponds to the second part of the "scheme" syntax
+     * specified in RFC 3986
+     */
+    inline constexpr CharacterSet SCHEME_NOT_FIRST{ALPHA, DIGIT, '+', '-', '.'};
+
+    /**
+     * This is the character st corresponds to the "pchar" syntax
+     * specified in RFC 3986, leaving out "pct-encoded".
+     */
+    inline constexpr CharacterSet PCHAR_NOT_PCT_ENCODED{UNRESERVED, SUB_DELIMS, ':', '@'};
+
+    /**
+     * This is the character set corresponds to a whole "path" (the
+     * "pchar" of every segment and the "/" between them) specified
+     * in RFC 3986, leaving out "pct-encoded".
+     */
+    inline constexpr CharacterSet PATH_CHAR_NOT_PCT_ENCODED{PCHAR_NOT_PCT_ENCODED, '/'};
+
+    /**
+     * This is the character set corresponds to the "query" and "fragment"
+     * syntax specified in RFC 3986, leaving out "pct-encoded".
+     */
+    inline constexpr CharacterSet QUERY_OR_FRAGMENT_CHAR{PCHAR_NOT_PCT_ENCODED, '/', '?'};
+
+    /**
+     * This is the character set corresponds to the "userinfo" syntax
+     * specified in RFC 3986, leaving out "pct-encoded".
+     */
+    inline constexpr CharacterSet USER_INFO_CHAR{UNRESERVED, SUB_DELIMS, ':'};
+
+    /**
+     * This is the character set corresponds to the "reg-name" syntax
+     * specified in RFC 3986 (https://tools.ietf.org/html/rfc3986),
+     * leaving out "pct-encoded".
+     */
+    inline constexpr CharacterSet REG_NAME_NOT_PCT_ENCODED{UNRESERVED, SUB_DELIMS};
+
+    /**
+     * This is the character set corresponds to the last part of
+     * the "IPvFuture" syntax specified in RFC 3986.
+     */
+    inline constexpr CharacterSet IPV_LAST_PART_FUTURE{UNRESERVED, SUB_DELIMS, ':'};
+
+    /**
+     * This represents the location of one element of a URI string,
+     * as an offset from the start of the string and a length.
+     */
+    struct ComponentRange
+    {
+        size_t offset = 0;
+        size_t length = 0;
+    };
+
+    /**
+     * This holds the location of every element of a URI string,
+     * found by a single scan over its delimiters.  None of the
+     * elements are validated or decoded here.
+     */
+    struct ComponentLayout
+    {
+        ComponentRange scheme;
+        ComponentRange userInfo;
+        ComponentRange host;
+        ComponentRange port;
+        ComponentRange path;
+        ComponentRange query;
+        ComponentRange fragment;
+        bool hasScheme = false;
+        bool hasAuthority = false;
+        bool hasUserInfo = false;
+        bool hostIsIpLiteral = false;
+        bool hasQuery = false;
+        bool hasFragment = false;
+    };
+
+    /**
+     * This function finds where the user info, host and port lie
+     * in the given authority of a URI string.
+     *
+     * @param[in] uriString
+     *      This is the URI string holding the authority.
+     * @param[in] authorityStart
+     *      This is the offset of the first character of the authority.
+     * @param[in] authorityEnd
+     *      This is the offset just past the last character of the authority.
+     * @param[in, out] layout
+     *      This is where to store the location of the user info,
+     *      host and port.
+     * @return
+     *      An indication of whether or not the delimiters of the
+     *      authority are consistent is returned.
+     */
+    bool LocateAuthority(std::string_view uriString, size_t authorityStart, size_t authorityEnd,
+                         ComponentLayout& layout);
+
+    /**
+     * This function returns an indication of whether or not the given
+     * mask holds any of the given elements.
+     *
+     * @param[in] mask
+     *      This is the mask to check.
+     * @param[in] components
+     *      These are the elements to look for.
+     * @return
+     *      An indication of whether or not the mask holds any
+     *      of the elements is returned.
+     */
+    inline bool HasAnyOf(ComponentMask mask, ComponentMask components) {
+        return ((mask & components) != ComponentMask::None);
+    }
+
+    /**
+     * This function finds the delimiters of the elements of the given
+     * URI string and records where each element lies.
+     *
+     * @param[in] uriString
+     *      This is the URI string to scan.
+     * @param[out] layout
+     *      This is where to store the location of each element.
+     * @param[in] components
+     *      These are the elements to locate.  Scanning stops
+     *      once the last of them is found, leaving the elements
+     *      after it unset in the layout.
+     * @return
+     *      An indication of whether or not the delimiters of the URI
+     *      string are consistent is returned.
+     */
+    bool LocateComponents(std::string_view uriString, ComponentLayout& layout,
+                          ComponentMask components = ComponentMask::All);
+
+    /**
+     * This function returns the part of the given URI string
+     * that the given range covers, without copying it.
+     *
+     * @param[in] uriString
+     *      This is the URI string holding the element.
+     * @param[in] range
+     *      This is the location of the element in the URI string.
+     * @return
+     *      A view of the element is returned.
+     */
+    inline std::string_view Slice(std::string_view uriString, const ComponentRange& range) {
+        return uriString.substr(range.offset, range.length);
+    }
+
+    /**
+     * This fuction parses the given string as an unsigned 16-bit
+     * integer, detecting invalid characters, overflow, etc..
+     *
+     * @param[in] numberString
+     *      This is the string containing the number to parse.
+     *
+     * @param[out] number
+     *      This is where to store the number parsed.
+     *
+     * @return
+     *      An indication of whether or not the number was parsed
+     *      successfully is returned.
+     */
+    bool ParseUint16(std::string_view numberString, uint16_t& number);
+
+    /**
+     * This is the room needed for the text of an IPv6 address,
+     * in the longest of its forms.
+     */
+    inline constexpr size_t IPV6_TEXT_SIZE = 45;
+
+    /**
+     * This function parses the given IPv4 address, as RFC 3986
+     * defines it (four decimal octets without leading zeros).
+     *
+     * @param[in] address
+     *      This is the IPv4 address to parse.
+     * @param[out] value
+     *      This is where to store the address, with its first
+     *      octet in the most significant byte.
+     * @return
+     *      An indication of whether or not the address is a valid
+     *      IPv4 address is returned.
+     */
+    bool ParseIPv4Address(std::string_view address, uint32_t& value);
+
+    /**
+     * This function parses the given IPv6 address, as RFC 3986
+     * defines it, in a single pass.
+     *
+     * @param[in] address
+     *      This is the IPv6 address to parse.
+     * @param[out] bytes
+     *      This is where to store the 16 bytes of the address,
+     *      in network order.
+     * @return
+     *      An indication of whether or not the address is a valid
+     *      IPv6 address is returned.
+     */
+    bool ParseIPv6Address(std::string_view address, uint8_t (&bytes)[16]);
+
+    /**
+     * This function parses the contents of an "IP-literal" host
+     * (the part between the brackets), which is either an IPv6
+     * address or an "IPvFuture" address.
+     *
+     * @param[in] literal
+     *      This is the contents of the IP-literal to parse.
+     * @param[out] address
+     *      This is where to store the address, if it is an IPv6 one.
+     * @return
+     *      An indication of whether or not the IP-literal is valid
+     *      is returned.
+     */
+    bool ParseIpLiteral(std::string_view literal, HostAddress& address);
+
+    /**
+     * This function checks to make sure that the contents of an
+     * "IP-literal" host (the part between the brackets) is either
+     * a valid IPv6 address or a valid "IPvFuture" address.
+     *
+     * @param[in] literal
+     *      This is the contents of the IP-literal to validate.
+     * @return
+     *      An indication of whether or not the IP-literal is valid
+     *      is returned.
+     */
+    bool ValidateIpLiteral(std::string_view literal);
+
+    /**
+     * This function works out the kind and numeric address of a host
+     * given without brackets, as by Uri::SetHost.  An IPvFuture address
+     * is only recognized if it holds a ":", which a reg-name could
+     * not hold without percent-encoding it.
+     *
+     * @param[in] host
+     *      This is the host to classify.
+     * @param[out] address
+     *      This is where to store the numeric address of the host,
+     *      with no family if the host is not an IPv4 or IPv6 address.
+     * @return
+     *      The kind of the host is returned.
+     */
+    HostKind ClassifyHost(std::string_view host, HostAddress& address);
+
+    /**
+     * This function renders the given IPv6 address in the canonical
+     * text form of RFC 5952: lowercase hex digits without leading
+     * zeros, the longest run of zero groups shortened to "::", and
+     * the last 32 bits in dotted decimal for the prefixes known to
+     * embed an IPv4 address.
+     *
+     * @param[in] bytes
+     *      These are the 16 bytes of the address, in network order.
+     * @param[out] text
+     *      This is where to write the text.
+     * @return
+     *      A view of the text written is returned.
+     */
+    std::string_view FormatIPv6Address(const uint8_t (&bytes)[16], char (&text)[IPV6_TEXT_SIZE]);
+
+    /**
+     * This function checks to make sure that the given scheme
+     * is legal according to the standard (an ALPHA followed by
+     * any number of ALPHA, DIGIT, "+", "-" or ".").
+     *
+     * @param[in] scheme
+     *      This is the scheme to validate.
+     * @return
+     *      An indication of whether or not the scheme is legal is returned.
+     */
+    bool ValidateScheme(std::string_view scheme);
+
+    /**
+     * This function checks the given URI element, making sure
+     * every character is either allowed or part of a well-formed
+     * percent-encoding, without decoding it.
+     *
+     * @param[in] element
+     *      This is the uri element to check.
+     * @param[in] allowedCharacters
+     *      This is the set of characters tha do not need to
+     *      be percent-encoded.
+     * @return
+     *      return an indication of whether or not the element
+     *      passed all checks.
+     */
+    bool ValidateElement(std::string_view element, const CharacterSet& allowedCharacters);
+
+    /**
+     * This function checks and decodes the given URI element.
+     *
+     * @param[in] element
+     *      This is the uri element to check and decode.
+     * @param[in] allowedCharacters
+     *      This is the set of characters tha do not need to
+     *      be percent-encoded.
+     * @param[out] decodedElement
+     *      This is where to store the decoded element.  Its
+     *      previous contents are replaced, but its capacity is kept.
+     * @return
+     *      return an indication of whether or not the element
+     *      passed all checks and was decoded successfully.
+     */
+    bool DecodeElement(std::string_view element, const CharacterSet& allowedCharacters,
+                       std::pmr::string& decodedElement);
+
+    /**
+     * This function checks and decodes the given URI element,
+     * adding it at the end of the given string.
+     *
+     * @param[in] element
+     *      This is the uri element to check and decode.
+     * @param[in] allowedCharacters
+     *      This is the set of characters tha do not need to
+     *      be percent-encoded.
+     * @param[in, out] output
+     *      This is the string to which to append the decoded element.
+     *      If the element is not valid, its contents are unspecified.
+     * @return
+     *      return an indication of whether or not the element
+     *      passed all checks and was decoded successfully.
+     */
+    bool AppendDecodedElement(std::string_view element, const CharacterSet& allowedCharacters,
+                              std::pmr::string& output);
+
+    /**
+     * This function converts the ASCII letters of the given string
+     * to lower case, in place, without reallocating it.
+     *
+     * @param[in, out] element
+     *      This is the string to convert.
+     */
+    void LowerCaseInPlace(std::pmr::string& element);
+
+    /**
+     * This function decodes a key or value of a query parameter as
+     * DecodeQueryComponent does, into the given buffer.
+     *
+     * @param[in] encoded
+     *      This is the key or value to decode.
+     * @param[out] decoded
+     *      This is where to write the decoded characters.  It must have
+     *      room for as many characters as there are in the encoded key
+     *      or value, since decoding never makes it longer.
+     * @param[in] plusAsSpace
+     *      This indicates whether or not to turn "+" into a space.
+     * @return
+     *      The number of characters written is returned.
+     */
+    size_t DecodeQueryComponentTo(std::string_view encoded, char* decoded, bool plusAsSpace);
+}  // namespace Uri
+
+#endif /* URI_URI_COMPONENTS_HPP */
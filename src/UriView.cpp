@@ -0,0 +1,104 @@
+/**
+ * @file UriView.cpp
+ *
+ * This module contains the implementation of the Uri::UriView class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "PercentEncodedCharacterDecoder.hpp"
+#include "UriComponents.hpp"
+#include <Uri/UriView.hpp>
+
+namespace
+{
+    /**
+     * This function decodes an element which has already been
+     * validated by UriView::Parse.
+     *
+     * @param[in] element
+     *      This is the encoded element to decode.
+     * @return
+     *      The decoded element is returned.
+     */
+    std::string DecodeValidElement(std::string_view element) {
+        std::string decodedElement(element.length(), '\0');
+        const auto decodedLength =
+            Uri::PercentEncodedCharacterDecoder::Decode(element, &decodedElement[0]);
+        decodedElement.resize(decodedLength);
+        return decodedElement;
+    }
+}  // namespace
+
+namespace Uri
+{
+    bool UriView::Parse(std::string_view uriString) {
+        *this = UriView();
+        ComponentLayout layout;
+        if (!LocateComponents(uriString, layout))
+        { return false; }
+
+        if (layout.hasScheme)
+        {
+            scheme_ = Slice(uriString, layout.scheme);
+            if (!ValidateScheme(scheme_))
+            { return false; }
+        }
+
+        hasAuthority_ = layout.hasAuthority;
+        if (hasAuthority_)
+        {
+            userInfo_ = Slice(uriString, layout.userInfo);
+            if (!ValidateElement(userInfo_, USER_INFO_CHAR))
+            { return false; }
+            host_ = Slice(uriString, layout.host);
+            if (layout.hostIsIpLiteral)
+            {
+                if (!ValidateIpLiteral(host_))
+                { return false; }
+            } else if (!ValidateElement(host_, REG_NAME_NOT_PCT_ENCODED))
+            { return false; }
+            const auto portString = Slice(uriString, layout.port);
+            if (!portString.empty())
+            {
+                if (!ParseUint16(portString, port_))
+                { return false; }
+                hasPort_ = true;
+            }
+        }
+
+        path_ = Slice(uriString, layout.path);
+        size_t segmentStart = 0;
+        for (;;)
+        {
+            const auto delimiter = path_.find('/', segmentStart);
+            if (!ValidateElement(path_.substr(segmentStart, delimiter - segmentStart),
+                                 PCHAR_NOT_PCT_ENCODED))
+            { return false; }
+            if (delimiter == std::string_view::npos)
+            { break; }
+            segmentStart = delimiter + 1;
+        }
+
+        hasQuery_ = layout.hasQuery;
+        query_ = Slice(uriString, layout.query);
+        if (!ValidateElement(query_, QUERY_OR_FRAGMENT_CHAR))
+        { return false; }
+
+        hasFragment_ = layout.hasFragment;
+        fragment_ = Slice(uriString, layout.fragment);
+        if (!ValidateElement(fragment_, QUERY_OR_FRAGMENT_CHAR))
+        { return false; }
+        return true;
+    }
+
+    std::string UriView::GetDecodedUserInfo() const { return DecodeValidElement(userInfo_); }
+
+    std::string UriView::GetDecodedHost() const { return DecodeValidElement(host_); }
+
+    std::string UriView::GetDecodedPath() const { return DecodeValidElement(path_); }
+
+    std::string UriView::GetDecodedQuery() const { return DecodeValidElement(query_); }
+
+    std::string UriView::GetDecodedFragment() const { return DecodeValidElement(fragment_); }
+}  // namespace Uri
@@ -0,0 +1,90 @@
+/**
+ * @file BatchParserTests.cpp
+ *
+ * This module contains unit Tests of the Uri::BatchParser class
+ *
+ * © 2024 by Hatem Nabli
+ */
+#include <gtest/gtest.h>
+#include <Uri/BatchParser.hpp>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+TEST(BatchParserTests, ParseBatchKeepsOrderAndMarksFailures_Test) {
+    std::vector<std::string> strings;
+    for (size_t i = 0; i < 5000; ++i)
+    {
+        if (i % 7 == 3)
+        {
+            strings.push_back("http://example.com:99999/" + std::to_string(i));
+        } else
+        { strings.push_back("http://example.com/" + std::to_string(i)); }
+    }
+    const std::vector<std::string_view> inputs(strings.begin(), strings.end());
+    Uri::BatchParser parser(4);
+    ASSERT_EQ(4, parser.GetThreadCount());
+    Uri::BatchParseResults results;
+    parser.ParseBatch(inputs.data(), inputs.size(), results);
+    ASSERT_EQ(inputs.size(), results.uris.size());
+    size_t expectedParsedCount = 0;
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        ASSERT_EQ(i % 7 != 3, results.IsParsed(i)) << i;
+        if (results.IsParsed(i))
+        {
+            ++expectedParsedCount;
+            ASSERT_EQ(std::to_string(i), results.uris[i].GetPathSegments().back()) << i;
+        }
+    }
+    ASSERT_EQ(expectedParsedCount, results.parsedCount);
+}
+
+TEST(BatchParserTests, ResultsReusedAcrossBatches_Test) {
+    Uri::BatchParser parser(2);
+    Uri::BatchParseResults results;
+    const std::vector<std::string_view> first(1000, "http://example.com/first");
+    parser.ParseBatch(first.data(), first.size(), results);
+    ASSERT_EQ(1000, results.parsedCount);
+    const std::vector<std::string_view> second{"x://y/z", "::"};
+    parser.ParseBatch(second.data(), second.size(), results);
+    ASSERT_EQ(2, results.uris.size());
+    ASSERT_EQ(1, results.parsedCount);
+    ASSERT_TRUE(results.IsParsed(0));
+    ASSERT_FALSE(results.IsParsed(1));
+    ASSERT_EQ("y", results.uris[0].GetHostView());
+}
+
+TEST(BatchParserTests, ParseBatchLines_Test) {
+    Uri::BatchParser parser(1);
+    Uri::BatchParseResults results;
+    parser.ParseBatchLines("http://a/\r\n\nhttp://b:x/\nhttp://c/last", results);
+    ASSERT_EQ(4, results.uris.size());
+    ASSERT_TRUE(results.IsParsed(0));
+    ASSERT_EQ("a", results.uris[0].GetHostView());
+    ASSERT_TRUE(results.IsParsed(1));
+    ASSERT_TRUE(results.uris[1].GetPathSegments().empty());
+    ASSERT_FALSE(results.IsParsed(2));
+    ASSERT_TRUE(results.IsParsed(3));
+    ASSERT_EQ("c", results.uris[3].GetHostView());
+    parser.ParseBatchLines("http://a/\n", results);
+    ASSERT_EQ(1, results.uris.size());
+}
+
+TEST(BatchParserTests, ResultsAllocatedFromMemoryResource_Test) {
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::monotonic_buffer_resource otherArena;
+    Uri::BatchParser parser(2);
+    Uri::BatchParseResults results;
+    results.memoryResource = &arena;
+    const std::vector<std::string_view> inputs(600, "http://example.com/a/b?c#d");
+    parser.ParseBatch(inputs.data(), inputs.size(), results);
+    ASSERT_EQ(600, results.parsedCount);
+    for (const auto& uri : results.uris)
+    { ASSERT_EQ(&arena, uri.GetMemoryResource()); }
+    results.memoryResource = &otherArena;
+    parser.ParseBatch(inputs.data(), 300, results);
+    ASSERT_EQ(300, results.parsedCount);
+    for (const auto& uri : results.uris)
+    { ASSERT_EQ(&otherArena, uri.GetMemoryResource()); }
+}
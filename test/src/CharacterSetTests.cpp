@@ -79,4 +79,25 @@ TEST(CharacterSetTests, InitializerListConstructor_Test) {
     }
 }
 
-TEST(CharacterSetTests, Contains) {}
\ No newline at end of file
+TEST(CharacterSetTests, Contains) {
+    const Uri::CharacterSet charSet{Uri::CharacterSet('\x80', '\x81'), Uri::CharacterSet('\xff'),
+                                    Uri::CharacterSet('\0')};
+    for (int value = 0; value < 256; ++value)
+    {
+        const auto c = (char)value;
+        if ((value == 0) || (value == 0x80) || (value == 0x81) || (value == 0xFF))
+        {
+            ASSERT_TRUE(charSet.Contains(c)) << value;
+        } else
+        { ASSERT_FALSE(charSet.Contains(c)) << value; }
+    }
+}
+
+TEST(CharacterSetTests, ConstantExpression_Test) {
+    constexpr Uri::CharacterSet charSet{Uri::CharacterSet('a', 'z'), Uri::CharacterSet('-')};
+    static_assert(charSet.Contains('q'), "'q' should be in the set");
+    static_assert(charSet.Contains('-'), "'-' should be in the set");
+    static_assert(!charSet.Contains('A'), "'A' should not be in the set");
+    constexpr Uri::CharacterSet copy = charSet;
+    ASSERT_TRUE(copy.Contains('z'));
+}
\ No newline at end of file
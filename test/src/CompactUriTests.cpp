@@ -0,0 +1,131 @@
+/**
+ * @file CompactUriTests.cpp
+ *
+ * This module contains unit Tests of the Uri::CompactUri class
+ *
+ * © 2024 by Hatem Nabli
+ */
+#include <gtest/gtest.h>
+#include <Uri/CompactUri.hpp>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+TEST(CompactUriTests, ElementsMatchParsedUri_Test) {
+    Uri::Uri uri;
+    ASSERT_TRUE(uri.ParseFromString(
+        "http://joe:pw@www.Example.com:8080/foo/bar%2Fbaz/?q=1%20#frag"));
+    const Uri::CompactUri compact(uri);
+    ASSERT_EQ("http", compact.GetScheme());
+    ASSERT_EQ("joe", compact.GetUserName());
+    ASSERT_EQ("pw", compact.GetUserPass());
+    ASSERT_EQ("www.example.com", compact.GetHost());
+    ASSERT_TRUE(compact.HasPort());
+    ASSERT_EQ(8080, compact.GetPort());
+    ASSERT_TRUE(compact.HasQuery());
+    ASSERT_EQ("q=1 ", compact.GetQuery());
+    ASSERT_TRUE(compact.HasFragment());
+    ASSERT_EQ("frag", compact.GetFragment());
+    ASSERT_FALSE(compact.IsRelativeReference());
+    const auto segments = compact.GetPathSegments();
+    ASSERT_EQ((std::vector<std::string_view>{"", "foo", "bar/baz", ""}),
+              std::vector<std::string_view>(segments.begin(), segments.end()));
+    ASSERT_EQ(uri, compact.ToUri());
+}
+
+TEST(CompactUriTests, AbsentElements_Test) {
+    Uri::CompactUri compact;
+    ASSERT_TRUE(compact.IsRelativeReference());
+    ASSERT_EQ(0, compact.GetHeapSize());
+    ASSERT_TRUE(compact.ParseFromString("foo/bar"));
+    ASSERT_TRUE(compact.IsRelativeReference());
+    ASSERT_FALSE(compact.HasPort());
+    ASSERT_FALSE(compact.HasQuery());
+    ASSERT_FALSE(compact.HasFragment());
+    ASSERT_EQ(2, compact.GetPathSegments().size());
+    ASSERT_FALSE(compact.ParseFromString("http://example.com:x/"));
+    ASSERT_EQ("bar", compact.GetPathSegments().back());
+    ASSERT_TRUE(compact.ParseFromString("http://example.com?#"));
+    ASSERT_TRUE(compact.HasQuery());
+    ASSERT_TRUE(compact.GetQuery().empty());
+    ASSERT_TRUE(compact.HasFragment());
+    ASSERT_TRUE(compact.GetFragment().empty());
+}
+
+TEST(CompactUriTests, ShortUrisStayInline_Test) {
+    ASSERT_LE(sizeof(Uri::CompactUri), 64);
+    Uri::CompactUri small;
+    ASSERT_TRUE(small.ParseFromString("http://a.io/x"));
+    ASSERT_EQ(0, small.GetHeapSize());
+    ASSERT_EQ("a.io", small.GetHost());
+    Uri::CompactUri large;
+    ASSERT_TRUE(large.ParseFromString("https://www.example.com/some/longer/path?with=query"));
+    ASSERT_GT(large.GetHeapSize(), 0);
+
+    auto copy = large;
+    ASSERT_EQ(large, copy);
+    auto moved = std::move(copy);
+    ASSERT_EQ(large, moved);
+    moved = small;
+    ASSERT_EQ(small, moved);
+    moved = std::move(large);
+    ASSERT_EQ("www.example.com", moved.GetHost());
+}
+
+TEST(CompactUriTests, EqualityAndHashAgreeWithUri_Test) {
+    const std::vector<std::string> uriStrings{
+        "http://example.com/a",   "http://EXAMPLE.com/a", "http://example.com/a?",
+        "http://example.com/a#",  "http://example.com/a/", "http://example.com:80/a",
+        "http://example.com/a%2F", "http://example.com/a/%2F", "http://[::1]/a",
+        "http://[0:0::1]/a",       "http://[::2]/a",
+    };
+    for (const auto& lhsString : uriStrings)
+    {
+        for (const auto& rhsString : uriStrings)
+        {
+            Uri::Uri lhs, rhs;
+            ASSERT_TRUE(lhs.ParseFromString(lhsString));
+            ASSERT_TRUE(rhs.ParseFromString(rhsString));
+            const Uri::CompactUri compactLhs(lhs), compactRhs(rhs);
+            ASSERT_EQ(lhs == rhs, compactLhs == compactRhs) << lhsString << " " << rhsString;
+            if (compactLhs == compactRhs)
+            { ASSERT_EQ(compactLhs.GetHash(), compactRhs.GetHash()); }
+        }
+    }
+    std::unordered_set<Uri::CompactUri> set;
+    for (const auto& uriString : uriStrings)
+    {
+        Uri::CompactUri compact;
+        ASSERT_TRUE(compact.ParseFromString(uriString));
+        (void)set.insert(compact);
+    }
+    ASSERT_EQ(uriStrings.size() - 2, set.size());
+}
+
+TEST(CompactUriTests, IPv6HostPackedInCanonicalForm_Test) {
+    Uri::Uri uri;
+    ASSERT_TRUE(uri.ParseFromString("http://[2001:DB8:0:0::1]:8080/a"));
+    const Uri::CompactUri compact(uri);
+    ASSERT_EQ("2001:db8::1", compact.GetHost());
+    ASSERT_EQ(uri, compact.ToUri());
+    ASSERT_EQ("http://[2001:db8::1]:8080/a", compact.ToUri().GenerateString());
+}
+
+TEST(CompactUriTests, HostKindPacked_Test) {
+    Uri::Uri regName, future;
+    ASSERT_TRUE(regName.ParseFromString("http://v7.a%3Ab/"));
+    ASSERT_TRUE(future.ParseFromString("http://[v7.a:b]/"));
+    const Uri::CompactUri compactRegName(regName), compactFuture(future);
+    ASSERT_EQ(Uri::HostKind::RegName, compactRegName.GetHostKind());
+    ASSERT_EQ(Uri::HostKind::IPvFuture, compactFuture.GetHostKind());
+    ASSERT_NE(compactRegName, compactFuture);
+    ASSERT_EQ(regName, compactRegName.ToUri());
+    ASSERT_EQ(future, compactFuture.ToUri());
+    ASSERT_EQ("http://v7.a%3Ab/", compactRegName.ToUri().GenerateString());
+    ASSERT_EQ("http://[v7.a:b]/", compactFuture.ToUri().GenerateString());
+
+    Uri::Uri address;
+    ASSERT_TRUE(address.ParseFromString("http://1.2.3.4/"));
+    ASSERT_EQ(Uri::HostKind::IPv4, Uri::CompactUri(address).GetHostKind());
+    ASSERT_EQ(Uri::HostKind::IPv4, Uri::CompactUri(address).ToUri().GetHostKind());
+}
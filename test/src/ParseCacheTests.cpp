@@ -0,0 +1,78 @@
+/**
+ * @file ParseCacheTests.cpp
+ *
+ * This module contains unit Tests of the Uri::ParseCache class
+ *
+ * © 2024 by Hatem Nabli
+ */
+#include <gtest/gtest.h>
+#include <Uri/ParseCache.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(ParseCacheTests, HitReturnsSameSharedUri_Test) {
+    Uri::ParseCache cache(16, 4);
+    const auto first = cache.Parse("http://example.com/a");
+    ASSERT_NE(nullptr, first);
+    ASSERT_EQ("example.com", first->GetHostView());
+    const auto second = cache.Parse(std::string("http://example.com/a"));
+    ASSERT_EQ(first.get(), second.get());
+    ASSERT_EQ(1, cache.GetSize());
+    const auto statistics = cache.GetStatistics();
+    ASSERT_EQ(1, statistics.hits);
+    ASSERT_EQ(1, statistics.misses);
+    ASSERT_EQ(0, statistics.evictions);
+}
+
+TEST(ParseCacheTests, BadStringsAreNotCached_Test) {
+    Uri::ParseCache cache(16);
+    ASSERT_EQ(nullptr, cache.Parse("http://example.com:x/"));
+    ASSERT_EQ(nullptr, cache.Parse("http://example.com:x/"));
+    ASSERT_EQ(0, cache.GetSize());
+    ASSERT_EQ(2, cache.GetStatistics().misses);
+}
+
+TEST(ParseCacheTests, ClockEvictionKeepsReferencedEntries_Test) {
+    Uri::ParseCache cache(3, 1);
+    const auto a = cache.Parse("http://a/");
+    (void)cache.Parse("http://b/");
+    (void)cache.Parse("http://c/");
+    ASSERT_EQ(a.get(), cache.Parse("http://a/").get());
+    (void)cache.Parse("http://d/");
+    ASSERT_EQ(3, cache.GetSize());
+    ASSERT_EQ(1, cache.GetStatistics().evictions);
+    ASSERT_EQ(a.get(), cache.Parse("http://a/").get());
+    const auto hitsBefore = cache.GetStatistics().hits;
+    (void)cache.Parse("http://b/");
+    ASSERT_EQ(hitsBefore, cache.GetStatistics().hits);
+    ASSERT_EQ("a", a->GetHostView());
+    cache.Clear();
+    ASSERT_EQ(0, cache.GetSize());
+    ASSERT_EQ("a", a->GetHostView());
+}
+
+TEST(ParseCacheTests, SharedBetweenThreads_Test) {
+    Uri::ParseCache cache(64, 8);
+    std::vector<std::thread> threads;
+    std::vector<size_t> failures(4, 0);
+    for (size_t t = 0; t < failures.size(); ++t)
+    {
+        threads.emplace_back([&cache, &failures, t] {
+            for (size_t i = 0; i < 2000; ++i)
+            {
+                const auto path = std::to_string(i % 100);
+                const auto uri = cache.Parse("http://example.com/" + path);
+                if ((uri == nullptr) || (uri->GetPathSegments().back() != path))
+                { ++failures[t]; }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    { thread.join(); }
+    for (const auto failureCount : failures)
+    { ASSERT_EQ(0, failureCount); }
+    const auto statistics = cache.GetStatistics();
+    ASSERT_EQ(8000, statistics.hits + statistics.misses);
+    ASSERT_LE(cache.GetSize(), 64);
+}
@@ -7,6 +7,8 @@
  */
 #include <gtest/gtest.h>
 #include <src/PercentEncodedCharacterDecoder.hpp>
+#include <string>
+#include <type_traits>
 
 TEST(PercentEncodedCharacterDecoderTests, GoodSequences) {
     Uri::PercentEncodedCharacterDecoder pec;
@@ -16,4 +18,97 @@ TEST(PercentEncodedCharacterDecoderTests, GoodSequences) {
     ASSERT_TRUE(pec.NextEncodedCharacter('1'));
     ASSERT_TRUE(pec.Done());
     ASSERT_EQ('A', pec.GetDecodedCharacter());
-}
\ No newline at end of file
+}
+
+TEST(PercentEncodedCharacterDecoderTests, EveryHexDigitCase) {
+    struct TestVector
+    {
+        char first;
+        char second;
+        char decoded;
+    };
+    const TestVector testVectors[]{
+        {'b', 'c', '\xbc'}, {'B', 'c', '\xbc'}, {'b', 'C', '\xbc'},
+        {'F', 'F', '\xff'}, {'0', '0', '\0'},   {'7', 'e', '~'},
+    };
+    size_t index = 0;
+    for (const auto& test : testVectors)
+    {
+        Uri::PercentEncodedCharacterDecoder pec;
+        ASSERT_TRUE(pec.NextEncodedCharacter(test.first)) << index;
+        ASSERT_TRUE(pec.NextEncodedCharacter(test.second)) << index;
+        ASSERT_TRUE(pec.Done()) << index;
+        ASSERT_EQ(test.decoded, pec.GetDecodedCharacter()) << index;
+        ++index;
+    }
+}
+
+TEST(PercentEncodedCharacterDecoderTests, BadSequences) {
+    Uri::PercentEncodedCharacterDecoder pec;
+    ASSERT_FALSE(pec.NextEncodedCharacter('G'));
+    ASSERT_FALSE(pec.NextEncodedCharacter('%'));
+    ASSERT_FALSE(pec.NextEncodedCharacter('\xc1'));
+    ASSERT_TRUE(pec.NextEncodedCharacter('4'));
+    ASSERT_TRUE(pec.NextEncodedCharacter('1'));
+    ASSERT_FALSE(pec.NextEncodedCharacter('1'));
+}
+
+TEST(PercentEncodedCharacterDecoderTests, IsTriviallyCopyable) {
+    ASSERT_TRUE(std::is_trivially_copyable<Uri::PercentEncodedCharacterDecoder>::value);
+    Uri::PercentEncodedCharacterDecoder pec;
+    ASSERT_TRUE(pec.NextEncodedCharacter('4'));
+    auto copy = pec;
+    ASSERT_TRUE(copy.NextEncodedCharacter('2'));
+    ASSERT_EQ('B', copy.GetDecodedCharacter());
+    ASSERT_FALSE(pec.Done());
+}
+
+TEST(PercentEncodedCharacterDecoderTests, DecodeWholeElement) {
+    struct TestVector
+    {
+        std::string encoded;
+        std::string decoded;
+    };
+    const TestVector testVectors[]{
+        {"", ""},
+        {"abc", "abc"},
+        {"%41%42%43", "ABC"},
+        {"caf%C3%A9+au+lait%3f", "caf\xC3\xA9+au+lait?"},
+        {"%2F%2f", "//"},
+    };
+    size_t index = 0;
+    for (const auto& test : testVectors)
+    {
+        std::string output(test.encoded.length(), '\0');
+        const auto length = Uri::PercentEncodedCharacterDecoder::Decode(test.encoded, &output[0]);
+        ASSERT_EQ(test.decoded, output.substr(0, length)) << index;
+        ++index;
+    }
+    char output[8];
+    ASSERT_EQ(std::string_view::npos, Uri::PercentEncodedCharacterDecoder::Decode("ab%4", output));
+    ASSERT_EQ(std::string_view::npos, Uri::PercentEncodedCharacterDecoder::Decode("%x1", output));
+}
+
+TEST(PercentEncodedCharacterDecoderTests, DecodeWithOptions) {
+    constexpr Uri::CharacterSet letters{'a', 'b', 'c', 'A', 'B', 'C'};
+    Uri::DecodingOptions options;
+    options.allowedCharacters = &letters;
+    char output[16];
+    ASSERT_EQ(3, Uri::PercentEncodedCharacterDecoder::Decode("a%2Fb", output, options));
+    ASSERT_EQ("a/b", std::string(output, 3));
+    ASSERT_EQ(std::string_view::npos,
+              Uri::PercentEncodedCharacterDecoder::Decode("a/b", output, options));
+
+    options = Uri::DecodingOptions();
+    options.plusAsSpace = true;
+    options.keepMalformed = true;
+    ASSERT_EQ(8, Uri::PercentEncodedCharacterDecoder::Decode("a+b%2b%zc%", output, options));
+    ASSERT_EQ("a b+%zc%", std::string(output, 8));
+
+    options = Uri::DecodingOptions();
+    options.decodedCharacters = &letters;
+    options.keepMalformed = true;
+    std::string inPlace("%61%2f%4%62");
+    inPlace.resize(Uri::PercentEncodedCharacterDecoder::Decode(inPlace, &inPlace[0], options));
+    ASSERT_EQ("a%2F%4b", inPlace);
+}
@@ -0,0 +1,106 @@
+/**
+ * @file QueryMapTests.cpp
+ *
+ * This module contains unit Tests of the Uri::QueryMap class
+ *
+ * © 2024 by Hatem Nabli
+ */
+#include <gtest/gtest.h>
+#include <Uri/QueryMap.hpp>
+#include <Uri/Uri.hpp>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /**
+     * This function returns the values of the parameters with
+     * the given key in the given map.
+     */
+    std::vector<std::string_view> GetValues(const Uri::QueryMap& map, std::string_view key) {
+        std::vector<std::string_view> values;
+        for (const auto entry : map.GetAll(key))
+        { values.push_back(entry.value); }
+        return values;
+    }
+}  // namespace
+
+TEST(QueryMapTests, Lookup_Test) {
+    const Uri::QueryMap map(Uri::QueryParameters("b=2&a=1&c&b=3&a%20b=x+y"));
+    ASSERT_EQ(5, map.GetSize());
+    ASSERT_TRUE(map.Has("a"));
+    ASSERT_TRUE(map.Has("c"));
+    ASSERT_TRUE(map.Has("a b"));
+    ASSERT_FALSE(map.Has("d"));
+    ASSERT_FALSE(map.Has("a%20b"));
+    ASSERT_EQ("1", map.Get("a"));
+    ASSERT_EQ("2", map.Get("b"));
+    ASSERT_EQ("", map.Get("c"));
+    ASSERT_EQ("", map.Get("d"));
+    ASSERT_EQ("x y", map.Get("a b"));
+    ASSERT_EQ((std::vector<std::string_view>{"2", "3"}), GetValues(map, "b"));
+    ASSERT_TRUE(map.GetAll("d").empty());
+    std::vector<std::string> keys;
+    for (const auto entry : map)
+    { keys.emplace_back(entry.key); }
+    ASSERT_EQ((std::vector<std::string>{"a", "a b", "b", "b", "c"}), keys);
+}
+
+TEST(QueryMapTests, SetAndRemove_Test) {
+    Uri::QueryMap map(Uri::QueryParameters("b=2&b=3&d=4"));
+    map.Set("b", "5");
+    ASSERT_EQ((std::vector<std::string_view>{"5"}), GetValues(map, "b"));
+    map.Set("c", "6");
+    map.Set("a", "7");
+    ASSERT_EQ("a=7&b=5&c=6&d=4", map.GenerateString());
+    ASSERT_EQ(1, map.Remove("c"));
+    ASSERT_EQ(0, map.Remove("c"));
+    ASSERT_EQ("a=7&b=5&d=4", map.GenerateString());
+    ASSERT_EQ(1, map.Remove("a"));
+    ASSERT_EQ(1, map.Remove("b"));
+    ASSERT_EQ(1, map.Remove("d"));
+    ASSERT_TRUE(map.IsEmpty());
+    ASSERT_EQ("", map.GenerateString());
+}
+
+TEST(QueryMapTests, CanonicalForm_Test) {
+    const std::vector<std::string> equivalentQueries{
+        "utm=a&q=hello+world&lang=en",
+        "lang=en&q=hello%20world&utm=a",
+        "&q=hello world&&%6Cang=e%6E&utm=a",
+    };
+    for (const auto& query : equivalentQueries)
+    {
+        ASSERT_EQ("lang=en&q=hello%20world&utm=a",
+                  Uri::QueryMap(Uri::QueryParameters(query)).GenerateString())
+            << query;
+    }
+    Uri::QueryMap map;
+    map.Set("k&=", "v/+?%");
+    std::string buffer("?");
+    map.AppendTo(buffer);
+    ASSERT_EQ("?k%26%3D=v%2F%2B%3F%25", buffer);
+}
+
+TEST(QueryMapTests, FromUri_Test) {
+    Uri::Uri uri;
+    ASSERT_TRUE(uri.ParseFromString("http://example.com/?z=1&y=%32", Uri::Decoding::Lazy));
+    const Uri::QueryMap map(uri.GetQueryParameters());
+    ASSERT_EQ("2", map.Get("y"));
+    ASSERT_EQ("y=2&z=1", map.GenerateString());
+}
+
+TEST(QueryMapTests, ChangesKeepViewsOfTheMapValid_Test) {
+    Uri::QueryMap map(Uri::QueryParameters("a=first&b=second&c=third"));
+    map.Set("d", map.Get("b"));
+    map.Set("a", map.Get("a").substr(1));
+    ASSERT_EQ("irst", map.Get("a"));
+    ASSERT_EQ("second", map.Get("d"));
+    for (size_t i = 0; i < 100; ++i)
+    {
+        map.Set("b", std::string(i % 20, 'x'));
+        ASSERT_EQ(std::string(i % 20, 'x'), map.Get("b"));
+    }
+    ASSERT_EQ("a=irst&b=" + std::string(99 % 20, 'x') + "&c=third&d=second",
+              map.GenerateString());
+}
@@ -0,0 +1,124 @@
+/**
+ * @file QueryParametersTests.cpp
+ *
+ * This module contains unit Tests of the Uri::QueryParameters class
+ *
+ * © 2024 by Hatem Nabli
+ */
+#include <gtest/gtest.h>
+#include <Uri/PushParser.hpp>
+#include <Uri/QueryParameters.hpp>
+#include <Uri/Uri.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    /**
+     * This function collects the raw parameters of the given query.
+     */
+    std::vector<std::pair<std::string, std::string>> Collect(std::string_view query) {
+        std::vector<std::pair<std::string, std::string>> parameters;
+        for (const auto& parameter : Uri::QueryParameters(query))
+        { parameters.emplace_back(parameter.key, parameter.value); }
+        return parameters;
+    }
+}  // namespace
+
+TEST(QueryParametersTests, SplitIntoPairs_Test) {
+    using Pairs = std::vector<std::pair<std::string, std::string>>;
+    ASSERT_EQ(Pairs(), Collect(""));
+    ASSERT_EQ(Pairs(), Collect("&&"));
+    ASSERT_EQ((Pairs{{"a", "1"}, {"b", "2"}}), Collect("a=1&b=2"));
+    ASSERT_EQ((Pairs{{"a", "1"}, {"b", "2"}}), Collect("&a=1&&b=2&"));
+    ASSERT_EQ((Pairs{{"flag", ""}, {"", "v"}, {"k", ""}}), Collect("flag&=v&k="));
+    ASSERT_EQ((Pairs{{"a", "b=c"}}), Collect("a=b=c"));
+    ASSERT_EQ((Pairs{{"a%26b", "c%3Dd"}}), Collect("a%26b=c%3Dd"));
+}
+
+TEST(QueryParametersTests, Find_Test) {
+    const Uri::QueryParameters parameters("utm_source=mail&id=7&id=8");
+    std::string_view value;
+    ASSERT_TRUE(parameters.Find("id", value));
+    ASSERT_EQ("7", value);
+    ASSERT_TRUE(parameters.Find("utm_source", value));
+    ASSERT_EQ("mail", value);
+    ASSERT_FALSE(parameters.Find("utm", value));
+}
+
+TEST(QueryParametersTests, DecodeQueryComponent_Test) {
+    struct TestVector
+    {
+        std::string encoded;
+        std::string decoded;
+        std::string decodedKeepingPlus;
+    };
+    const std::vector<TestVector> testVectors{
+        {"", "", ""},
+        {"plain", "plain", "plain"},
+        {"a+b", "a b", "a+b"},
+        {"a%20b", "a b", "a b"},
+        {"%2B+%26", "+ &", "++&"},
+        {"50%", "50%", "50%"},
+        {"%zz%4", "%zz%4", "%zz%4"},
+        {"%e2%82%ac", "\xe2\x82\xac", "\xe2\x82\xac"},
+    };
+    std::string scratch;
+    size_t index = 0;
+    for (const auto& testVector : testVectors)
+    {
+        ASSERT_EQ(testVector.decoded, Uri::DecodeQueryComponent(testVector.encoded, scratch))
+            << index;
+        ASSERT_EQ(testVector.decodedKeepingPlus,
+                  Uri::DecodeQueryComponent(testVector.encoded, scratch, false))
+            << index;
+        ++index;
+    }
+}
+
+TEST(QueryParametersTests, DecodeWithoutCopyingWhenNothingToDecode_Test) {
+    const std::string_view encoded("plain");
+    std::string scratch("left over");
+    const auto decoded = Uri::DecodeQueryComponent(encoded, scratch);
+    ASSERT_EQ(encoded.data(), decoded.data());
+    scratch.reserve(64);
+    const auto capacity = scratch.capacity();
+    const auto data = scratch.data();
+    ASSERT_EQ("a b", Uri::DecodeQueryComponent("a+b", scratch));
+    ASSERT_EQ("c&d", Uri::DecodeQueryComponent("c%26d", scratch));
+    ASSERT_EQ(capacity, scratch.capacity());
+    ASSERT_EQ(data, scratch.data());
+}
+
+TEST(QueryParametersTests, FromUri_Test) {
+    Uri::Uri uri;
+    ASSERT_TRUE(uri.ParseFromString("http://example.com/?q=a+b%26c&lang=en", Uri::Decoding::Lazy));
+    std::string scratch;
+    std::vector<std::string> values;
+    for (const auto& parameter : uri.GetQueryParameters())
+    { values.emplace_back(Uri::DecodeQueryComponent(parameter.value, scratch)); }
+    ASSERT_EQ((std::vector<std::string>{"a b&c", "en"}), values);
+    uri.ClearQuery();
+    ASSERT_EQ(uri.GetQueryParameters().begin(), uri.GetQueryParameters().end());
+}
+
+TEST(QueryParametersTests, FromEagerlyParsedUri_Test) {
+    Uri::Uri uri;
+    ASSERT_TRUE(uri.ParseFromString("http://h/p?a=1%262&b%3Dc=2"));
+    ASSERT_EQ("a=1%262&b%3Dc=2", uri.GetRawQuery());
+    std::vector<std::pair<std::string, std::string>> pairs;
+    for (const auto& parameter : uri.GetQueryParameters())
+    { pairs.emplace_back(parameter.key, parameter.value); }
+    ASSERT_EQ((std::vector<std::pair<std::string, std::string>>{{"a", "1%262"}, {"b%3Dc", "2"}}),
+              pairs);
+
+    Uri::PushParser parser;
+    const std::string_view chunks[] = {"http://h/p?a=1%2", "62&b%3Dc=2", "#frag"};
+    ASSERT_TRUE(parser.Feed(chunks, 3));
+    ASSERT_TRUE(parser.Finish(uri));
+    ASSERT_EQ("a=1%262&b%3Dc=2", uri.GetRawQuery());
+    ASSERT_EQ("frag", uri.GetRawFragment());
+    uri.SetQuery("x=&");
+    ASSERT_EQ("x=&", uri.GetRawQuery());
+}
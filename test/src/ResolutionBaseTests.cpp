@@ -0,0 +1,86 @@
+/**
+ * @file ResolutionBaseTests.cpp
+ *
+ * This module contains unit Tests of the Uri::ResolutionBase class
+ *
+ * © 2024 by Hatem Nabli
+ */
+#include <gtest/gtest.h>
+#include <Uri/ResolutionBase.hpp>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /**
+     * These are relative references covering every case
+     * of the resolution algorithm of RFC 3986.
+     */
+    const std::vector<std::string> TEST_REFERENCES{
+        "g:h",  "g",    "./g",     "g/",      "/g",     "//g",    "?y",     "g?y",
+        "#s",   "g#s",  "g?y#s",   ";x",      "g;x",    "g;x?y#s", "",      ".",
+        "./",   "..",   "../",     "../g",    "../..",  "../../", "../../g", "../../../g",
+        "/./g", "g.",   "./../g",  "./g/.",   "g/./h",  "g/../h", "g;x=1/./y", "%7e/a%2Fb",
+    };
+}  // namespace
+
+TEST(ResolutionBaseTests, SameAsResolve_Test) {
+    for (const auto baseString : {"http://a/b/c/d;p?q", "http://a", "http://a/b/../c/", "x:/"})
+    {
+        Uri::Uri base;
+        ASSERT_TRUE(base.ParseFromString(baseString, Uri::Decoding::Lazy));
+        const Uri::ResolutionBase resolutionBase(base);
+        Uri::Uri target;
+        for (const auto& referenceString : TEST_REFERENCES)
+        {
+            Uri::Uri reference;
+            ASSERT_TRUE(reference.ParseFromString(referenceString, Uri::Decoding::Lazy));
+            const auto expected = base.Resolve(reference);
+            resolutionBase.Resolve(reference, target);
+            ASSERT_EQ(expected, target) << baseString << " " << referenceString;
+            ASSERT_EQ(expected.GenerateString(), target.GenerateString())
+                << baseString << " " << referenceString;
+            ASSERT_EQ(expected, resolutionBase.Resolve(reference));
+            resolutionBase.Resolve(reference, reference);
+            ASSERT_EQ(expected, reference);
+        }
+    }
+}
+
+TEST(ResolutionBaseTests, AliasedTargetKeepsMemoryResource_Test) {
+    Uri::Uri base, expected;
+    ASSERT_TRUE(base.ParseFromString("http://a/b/c/d;p?q"));
+    ASSERT_TRUE(expected.ParseFromString("http://a/b/g?y#s"));
+    const Uri::ResolutionBase resolutionBase(base);
+    std::pmr::monotonic_buffer_resource arena;
+    Uri::Uri reference(&arena);
+    ASSERT_TRUE(reference.ParseFromString("../g?y#s"));
+    resolutionBase.Resolve(reference, reference);
+    ASSERT_EQ(expected, reference);
+    ASSERT_EQ(&arena, reference.GetMemoryResource());
+}
+
+TEST(ResolutionBaseTests, ResolveBatch_Test) {
+    Uri::Uri base;
+    ASSERT_TRUE(base.ParseFromString("http://example.com/docs/guide/index.html"));
+    const Uri::ResolutionBase resolutionBase(base);
+    std::vector<Uri::Uri> references;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        Uri::Uri reference;
+        ASSERT_TRUE(reference.ParseFromString(TEST_REFERENCES[i % TEST_REFERENCES.size()] +
+                                                  std::to_string(i),
+                                              Uri::Decoding::Lazy));
+        references.push_back(reference);
+    }
+    for (const size_t threadCount : {1, 4})
+    {
+        std::vector<Uri::Uri> targets(references.size());
+        resolutionBase.ResolveBatch(references.data(), references.size(), targets.data(),
+                                    threadCount);
+        for (size_t i = 0; i < references.size(); ++i)
+        { ASSERT_EQ(base.Resolve(references[i]), targets[i]) << i; }
+    }
+    resolutionBase.ResolveBatch(nullptr, 0, nullptr, 4);
+}
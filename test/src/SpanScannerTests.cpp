@@ -0,0 +1,78 @@
+/**
+ * @file SpanScannerTests.cpp
+ *
+ * This module contains unit Tests of the span scanner functions
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <gtest/gtest.h>
+#include <src/SpanScanner.hpp>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /**
+     * This returns every scan level supported by the processor
+     * running the tests.
+     */
+    std::vector<Uri::ScanLevel> SupportedLevels() {
+        std::vector<Uri::ScanLevel> levels{Uri::ScanLevel::Scalar};
+        for (auto level : {Uri::ScanLevel::Ssse3, Uri::ScanLevel::Avx2, Uri::ScanLevel::Avx512})
+        {
+            if (level <= Uri::GetSupportedScanLevel())
+            { levels.push_back(level); }
+        }
+        return levels;
+    }
+}  // namespace
+
+TEST(SpanScannerTests, EveryLevelFindsTheSameStop_Test) {
+    const Uri::CharacterSet charSet{Uri::CharacterSet('a', 'z'), Uri::CharacterSet('0', '9'),
+                                    Uri::CharacterSet('-')};
+    for (size_t length = 0; length < 200; ++length)
+    {
+        for (size_t stop = 0; stop <= length; ++stop)
+        {
+            std::string buffer(length, 'a');
+            for (size_t i = 0; i < length; ++i)
+            { buffer[i] = "abc-xyz0189"[i % 11]; }
+            if (stop < length)
+            { buffer[stop] = ((stop % 2) == 0) ? '/' : '\xE1'; }
+            for (auto level : SupportedLevels())
+            {
+                ASSERT_EQ(stop, Uri::FindFirstNotInSet(charSet, buffer.data(), length, level))
+                    << "level " << (int)level << ", length " << length << ", stop " << stop;
+            }
+            ASSERT_EQ(stop, Uri::FindFirstNotInSet(charSet, buffer.data(), length));
+        }
+    }
+}
+
+TEST(SpanScannerTests, EveryCharacterValue_Test) {
+    const Uri::CharacterSet charSet{Uri::CharacterSet('!', '~')};
+    std::string buffer(64, 'x');
+    for (int value = 0; value < 256; ++value)
+    {
+        buffer[40] = (char)value;
+        const size_t expected = charSet.Contains((char)value) ? 64 : 40;
+        for (auto level : SupportedLevels())
+        {
+            ASSERT_EQ(expected, Uri::FindFirstNotInSet(charSet, buffer.data(), 64, level))
+                << "level " << (int)level << ", value " << value;
+        }
+    }
+}
+
+TEST(SpanScannerTests, NonAsciiSet_Test) {
+    const Uri::CharacterSet charSet{Uri::CharacterSet('a', 'z'), Uri::CharacterSet('\x80', '\xff')};
+    ASSERT_FALSE(charSet.IsAscii());
+    const std::string buffer("abc\xC3\xA9\xE2\x82\xAC" "defghijklmnopqrstuvwxyz/abc");
+    for (auto level : SupportedLevels())
+    {
+        ASSERT_EQ(buffer.find('/'),
+                  Uri::FindFirstNotInSet(charSet, buffer.data(), buffer.length(), level))
+            << "level " << (int)level;
+    }
+}